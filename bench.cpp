@@ -0,0 +1,676 @@
+#include <cstdio>
+#include <chrono>
+#include <map>
+#include "s7.hpp"
+
+// times n iterations of fn and returns nanoseconds per iteration
+template <typename F>
+double ns_per_call(std::size_t n, F &&fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn(n);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / double(n);
+}
+
+void report(const char *name, double ns)
+{
+    printf("%-40s %8.2f ns/call\n", name, ns);
+}
+
+// calls the trampoline made by define_function directly, without going
+// through the evaluator, to isolate the cost of the wrapper itself
+void bench_trampoline()
+{
+    constexpr std::size_t N = 10'000'000;
+    s7::Scheme scheme;
+    auto sc = scheme.ptr();
+    auto args = scheme.list(1.0, 2.0).ptr();
+    scheme.protect(args);
+
+    auto stateless = s7::detail::make_s7_function(sc, "stateless", [](double a, double b) { return a + b; });
+    report("trampoline (captureless lambda)", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            stateless(sc, args);
+        }
+    }));
+
+    double k = 1.0;
+    auto stateful = s7::detail::make_s7_function(sc, "stateful", [k](double a, double b) { return a + b + k; });
+    report("trampoline (capturing lambda)", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            stateful(sc, args);
+        }
+    }));
+
+    auto overload = s7::detail::make_overload(sc, "overload", {},
+        [](s7_int a, s7_int b) { return a + b; },
+        [](double a, double b) { return a + b; });
+    report("trampoline (overload, 2nd match)", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            overload(sc, args);
+        }
+    }));
+}
+
+double add_double(double a, double b) { return a + b; }
+
+// the same function bound through a pointer stored in a trampoline slot, and
+// through a template parameter that needs no storage
+void bench_static_binding()
+{
+    constexpr std::size_t N = 10'000'000;
+    s7::Scheme scheme;
+    scheme.define_function("add-double-ptr", "doc", add_double);
+    scheme.define_function<&add_double>("add-double", "doc");
+    auto args = scheme.list(1.0, 2.0).ptr();
+    scheme.protect(args);
+    auto run = [&](const char *label, const char *name) {
+        auto f = s7_name_to_value(scheme.ptr(), name);
+        report(label, ns_per_call(N, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                s7_call(scheme.ptr(), f, args);
+            }
+        }));
+    };
+    run("trampoline (function pointer)", "add-double-ptr");
+    run("trampoline (define_function<&fn>)", "add-double");
+}
+
+struct vec2 { double x, y; };
+struct vec3 { double x, y, z; };
+
+// resolution cost of an overload whose match comes late, with and without
+// the last-match cache
+void bench_overload()
+{
+    constexpr std::size_t N = 10'000'000;
+    s7::Scheme scheme;
+    auto sc = scheme.ptr();
+    scheme.make_usertype<vec2>("vec2", s7::Constructors("vec2", [](double x, double y) { return vec2 { x, y }; }));
+    scheme.make_usertype<vec3>("vec3", s7::Constructors("vec3", [](double x, double y, double z) { return vec3 { x, y, z }; }));
+
+    auto make = [&](const char *name, s7::FunctionOpts opts) {
+        return s7::detail::make_overload(sc, name, opts,
+            [](s7_int a) { return a; },
+            [](std::string_view s) { return s7_int(s.size()); },
+            [](s7_int a, s7_int b) { return a * b; },
+            [](const vec3 &v, double k) { return v.x * k; },
+            [](const vec2 &v, s7_int k) { return v.y * double(k); },
+            [](const vec2 &v, double k) { return v.x * k; });
+    };
+
+    auto v = scheme.eval("(vec2 1.0 2.0)");
+    auto args = scheme.list(v, 2.0).ptr();
+    scheme.protect(args);
+
+    auto plain = make("overload", {});
+    report("overload (6 fns, usertype, last match)", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            plain(sc, args);
+        }
+    }));
+
+    auto cached = make("overload-cached", { .cache_overload = true });
+    report("overload (same, cached)", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            cached(sc, args);
+        }
+    }));
+}
+
+// calling a scheme procedure from C++ by name vs through a prepared handle
+void bench_prepared()
+{
+    constexpr std::size_t N = 1'000'000;
+    s7::Scheme scheme;
+    scheme.load_string("(define total 0.0) (define (on-tick dt) (set! total (+ total dt)) total)");
+
+    report("call by name", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.to<double>(scheme.call("on-tick", 0.5));
+        }
+    }));
+
+    auto fn = s7::Function(s7_name_to_value(scheme.ptr(), "on-tick"));
+    report("call through Function", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.to<double>(scheme.call(fn, 0.5));
+        }
+    }));
+
+    auto tick = scheme.prepare<double(double)>("on-tick");
+    report("prepared call", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            tick(0.5);
+        }
+    }));
+}
+
+// per-entity update through a C++ loop of calls vs one batched call
+void bench_map_into()
+{
+    constexpr std::size_t N = 1'000'000;
+    s7::Scheme scheme;
+    scheme.load_string("(define (update x) (* x 0.5))");
+    auto fn = s7::Function(s7_name_to_value(scheme.ptr(), "update"));
+    std::vector<double> in(N, 1.0), out(N);
+
+    report("loop of call()", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            out[i] = scheme.to<double>(scheme.call(fn, in[i]));
+        }
+    }));
+    report("map_into (closure)", ns_per_call(N, [&](std::size_t) {
+        scheme.map_into(fn, std::span<const double>(in), std::span<double>(out));
+    }));
+    auto sin = s7::Function(s7_name_to_value(scheme.ptr(), "sin"));
+    report("map_into (c function with d_d)", ns_per_call(N, [&](std::size_t) {
+        scheme.map_into(sin, std::span<const double>(in), std::span<double>(out));
+    }));
+}
+
+// a formula over three variables: eval per row vs compiled
+void bench_compile_float()
+{
+    constexpr std::size_t N = 1'000'000;
+    s7::Scheme scheme;
+    scheme.load_string("(define x 0.0) (define y 0.0) (define k 0.0)");
+    std::vector<double> x(N, 1.0), y(N, 2.0), k(N, 0.5), out(N);
+
+    report("eval per row", ns_per_call(N / 10, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.set("x", x[i]);
+            scheme.set("y", y[i]);
+            scheme.set("k", k[i]);
+            out[i] = scheme.to<double>(scheme.eval("(* k (+ x y))"));
+        }
+    }));
+
+    auto expr = scheme.compile_float("(* k (+ x y))", {"x", "y", "k"});
+    report("compiled, per row", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            out[i] = expr(x[i], y[i], k[i]);
+        }
+    }));
+    report("compiled, batch", ns_per_call(N, [&](std::size_t) {
+        expr.map_into(std::span<double>(out), std::span<const double>(x), std::span<const double>(y), std::span<const double>(k));
+    }));
+}
+
+// formatting each row into an expression vs the columnar engine
+void bench_eval_columns()
+{
+    constexpr std::size_t N = 1'000'000;
+    s7::Scheme scheme;
+    std::vector<double> x(N, 1.0), y(N, 2.0), out(N);
+    std::vector<s7_int> k(N, 3);
+
+    report("eval(std::format(...)) per row", ns_per_call(N / 10, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            out[i] = scheme.to<double>(scheme.eval(std::format("(* {} (+ {} {}))", k[i], x[i], y[i])));
+        }
+    }));
+    report("eval_columns", ns_per_call(N, [&](std::size_t) {
+        scheme.eval_columns("(* k (+ x y))", {
+            s7::Column("x", std::span<const double>(x)),
+            s7::Column("y", std::span<const double>(y)),
+            s7::Column("k", std::span<const s7_int>(k)),
+        }, out);
+    }));
+}
+
+// handing an 80 MB sample buffer to scheme: element by element, bulk copy,
+// adopting a FloatBuffer and borrowing
+void bench_vector_interop()
+{
+    constexpr std::size_t N = 10'000'000, reps = 20;
+    s7::Scheme scheme;
+    auto sc = scheme.ptr();
+    std::vector<double> samples(N, 1.0);
+
+    report("per-element s7_float_vector_set", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            auto vec = s7_make_float_vector(sc, N, 1, nullptr);
+            for (std::size_t i = 0; i < N; i++) {
+                s7_float_vector_set(vec, s7_int(i), samples[i]);
+            }
+        }
+    }));
+    report("from(std::vector<double>)", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            scheme.from(samples);
+        }
+    }));
+    report("from(FloatBuffer &&)", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            s7::FloatBuffer buf(N);
+            scheme.from(std::move(buf));
+        }
+    }));
+    report("borrow(std::span<double>)", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            auto view = scheme.borrow(samples);
+        }
+    }));
+}
+
+// float32 samples into a float-vector and back, element by element vs bulk
+void bench_vector_conversion()
+{
+    constexpr std::size_t N = 1'000'000, reps = 100;
+    s7::Scheme scheme;
+    auto sc = scheme.ptr();
+    std::vector<float> samples(N, 1.5f), out(N);
+
+    report("float -> float-vector, per element", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            auto vec = s7_make_float_vector(sc, N, 1, nullptr);
+            for (std::size_t i = 0; i < N; i++) {
+                s7_float_vector_set(vec, s7_int(i), samples[i]);
+            }
+        }
+    }));
+    report("float -> float-vector, from()", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            scheme.from(std::span<float>(samples));
+        }
+    }));
+
+    auto vec = scheme.from(std::span<float>(samples));
+    scheme.protect(vec);
+    report("float-vector -> float, per element", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            for (std::size_t i = 0; i < N; i++) {
+                out[i] = float(s7_float_vector_ref(vec, s7_int(i)));
+            }
+        }
+    }));
+    report("float-vector -> float, to()", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            out = scheme.to<std::vector<float>>(vec);
+        }
+    }));
+}
+
+// a table across the boundary, by hand vs the generic conversions
+void bench_containers()
+{
+    constexpr std::size_t N = 1000, reps = 1000;
+    s7::Scheme scheme;
+    auto sc = scheme.ptr();
+    std::map<s7_int, double> config;
+    for (std::size_t i = 0; i < N; i++) {
+        config[s7_int(i)] = double(i);
+    }
+
+    report("map -> hash-table, by hand", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            auto table = s7_gc_protect_via_stack(sc, s7_make_hash_table(sc, 8));
+            for (const auto &[k, v] : config) {
+                s7_hash_table_set(sc, table, s7_make_integer(sc, k), s7_make_real(sc, v));
+            }
+            s7_gc_unprotect_via_stack(sc, table);
+        }
+    }));
+    report("map -> hash-table, from()", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            scheme.from(config);
+        }
+    }));
+
+    auto table = scheme.from(config);
+    scheme.protect(table);
+    report("hash-table -> map, to()", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            scheme.to<std::map<s7_int, double>>(table);
+        }
+    }));
+}
+
+// a 1000x1000 matrix kernel: flattening and copying on both sides vs MdSpan
+void bench_mdspan()
+{
+    constexpr std::size_t N = 1000, reps = 20;
+    s7::Scheme scheme;
+    scheme.load_string("(define matrix (make-float-vector '(1000 1000) 1.0))");
+    auto matrix = scheme.eval("matrix");
+
+    report("to<std::vector<double>> + from()", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            auto flat = scheme.to<std::vector<double>>(matrix);
+            for (std::size_t i = 0; i < N; i++) {
+                flat[i * N + i] *= 2.0;
+            }
+            s7_int dims[2] = { N, N };
+            auto out = s7_make_float_vector(scheme.ptr(), N * N, 2, dims);
+            std::copy(flat.begin(), flat.end(), s7_float_vector_elements(out));
+        }
+    }));
+    report("to<MdSpan<double, 2>>", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            auto m = scheme.to<s7::MdSpan<double, 2>>(matrix);
+            for (std::size_t i = 0; i < N; i++) {
+                m(i, i) *= 2.0;
+            }
+        }
+    }));
+
+    std::vector<double> image(N * N, 1.0);
+    report("from(MdSpan<double, 2>)", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            scheme.from(s7::MdSpan<double, 2>(image.data(), { N, N }));
+        }
+    }));
+    report("borrow(MdSpan<double, 2>)", ns_per_call(reps, [&](std::size_t n) {
+        for (std::size_t r = 0; r < n; r++) {
+            auto view = scheme.borrow(s7::MdSpan<double, 2>(image.data(), { N, N }));
+        }
+    }));
+}
+
+// a scheme filter over 4 KB payloads: copied vs borrowed strings
+void bench_call_borrowed()
+{
+    constexpr std::size_t N = 1'000'000;
+    s7::Scheme scheme;
+    scheme.load_string("(define (accept? msg) (char=? (msg 0) #\\G))");
+    auto accept = s7::Function(s7_name_to_value(scheme.ptr(), "accept?"));
+    std::string payload(4096, 'x');
+    payload[0] = 'G';
+
+    report("call (copied string)", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.to<bool>(scheme.call(accept, payload));
+        }
+    }));
+    report("call_borrowed", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.to<bool>(scheme.call_borrowed(accept, payload));
+        }
+    }));
+
+    auto str = scheme.from(payload);
+    scheme.protect(str);
+    report("to<std::string_view> (4 KB)", ns_per_call(N, [&](std::size_t n) {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            total += scheme.to<std::string_view>(str).size();
+        }
+        if (total == 0) {
+            printf("unreachable\n");
+        }
+    }));
+}
+
+// reading and writing a global by name vs through a cached symbol
+void bench_symbols()
+{
+    constexpr std::size_t N = 10'000'000;
+    s7::Scheme scheme;
+    scheme.define("on-tick-interval", 0.016);
+
+    report("get/set by name", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.set("on-tick-interval", scheme.get<double>("on-tick-interval") + 1.0);
+        }
+    }));
+    report("get/set by s7::sym", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.set(s7::sym<"on-tick-interval">, scheme.get<double>(s7::sym<"on-tick-interval">) + 1.0);
+        }
+    }));
+}
+
+// pushing per-frame values into script globals
+void bench_bound_variable()
+{
+    constexpr std::size_t N = 10'000'000;
+    s7::Scheme scheme;
+    scheme.define("player-x", 0.0, "player position");
+    auto x = scheme.variable<double>("player-x");
+
+    report("set by name", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.set("player-x", double(i));
+        }
+    }));
+    report("BoundVariable::set", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            x = double(i);
+        }
+    }));
+    report("BoundVariable::set_in_place", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            x.set_in_place(double(i));
+        }
+    }));
+}
+
+// a script integrating with the engine's time step each frame: a bound C++
+// field vs copying the value in before every call
+void bench_bind_variable()
+{
+    constexpr std::size_t N = 1'000'000;
+    struct Engine {
+        double dt = 0.016;
+        double other[16] = {};
+    } engine;
+    s7::Scheme scheme;
+    scheme.define("copied-dt", 0.016, "frame time");
+    for (std::size_t i = 0; i < 16; i++) {
+        scheme.bind_variable(std::format("field-{}", i), &engine.other[i], "unused field");
+    }
+    scheme.bind_variable("dt", &engine.dt, "frame time");
+    scheme.load_string("(define (step-copied x) (+ x (* copied-dt 2.0)))");
+    scheme.load_string("(define (step-bound x) (+ x (* dt 2.0)))");
+    auto copied = s7::Function(s7_name_to_value(scheme.ptr(), "step-copied"));
+    auto bound = s7::Function(s7_name_to_value(scheme.ptr(), "step-bound"));
+
+    report("copy in + call", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            engine.dt = double(i & 1);
+            scheme.set("copied-dt", engine.dt);
+            scheme.call(copied, 1.0);
+        }
+    }));
+    report("call with 17 bound fields", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            engine.dt = double(i & 1);
+            scheme.call(bound, 1.0);
+        }
+    }));
+}
+
+// a script churning through small usertype objects, with objects from
+// new/delete vs from the pool allocator
+void bench_pool_allocator()
+{
+    constexpr std::size_t N = 10'000'000;
+    auto run = [&](const char *label, auto alloc) {
+        s7::Scheme scheme;
+        scheme.make_usertype<vec2, decltype(alloc)>("vec2", s7::Constructors("vec2", [](double x, double y) { return vec2 { x, y }; }));
+        scheme.eval("(define (churn n) (do ((i 0 (+ i 1)) (v #f (vec2 1.0 2.0))) ((= i n) v)))");
+        report(label, ns_per_call(N, [&](std::size_t n) {
+            scheme.call("churn", s7_int(n));
+        }));
+    };
+    run("vec2 churn (new/delete)", s7::NewDelete{});
+    run("vec2 churn (PoolAllocator)", s7::PoolAllocator<>{});
+}
+
+// the rate at which usertype objects can be made from C++ and from scheme
+void bench_object_creation()
+{
+    constexpr std::size_t N = 10'000'000;
+    auto run = [&](const char *label, auto alloc) {
+        s7::Scheme scheme;
+        scheme.make_usertype<vec2, decltype(alloc)>("vec2", s7::Constructors("vec2", [](double x, double y) { return vec2 { x, y }; }));
+        scheme.eval("(define (make-many n) (do ((i 0 (+ i 1)) (v #f (vec2 1.0 2.0))) ((= i n) v)))");
+        report(std::format("from(vec2) ({})", label).c_str(), ns_per_call(N, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                scheme.from(vec2 { double(i), 0.0 });
+            }
+        }));
+        report(std::format("(vec2 x y) in a loop ({})", label).c_str(), ns_per_call(N, [&](std::size_t n) {
+            scheme.call("make-many", s7_int(n));
+        }));
+    };
+    run("new/delete", s7::NewDelete{});
+    run("PoolAllocator", s7::PoolAllocator<>{});
+}
+
+// numeric loops should run just as fast once a usertype defines +, - and <,
+// since those only reach the type's methods when one of its objects shows up
+void bench_method_ops()
+{
+    constexpr std::size_t N = 10'000'000;
+    auto run = [&](const char *label, bool with_ops) {
+        s7::Scheme scheme;
+        if (with_ops) {
+            scheme.make_usertype<vec2>("vec2",
+                s7::Constructors("vec2", [](double x, double y) { return vec2 { x, y }; }),
+                s7::MethodOp::Add, [](const vec2 &a, const vec2 &b) { return vec2 { a.x + b.x, a.y + b.y }; },
+                s7::MethodOp::Sub, [](const vec2 &a, const vec2 &b) { return vec2 { a.x - b.x, a.y - b.y }; },
+                s7::MethodOp::Lt,  [](const vec2 &a, const vec2 &b) { return a.x < b.x; });
+        }
+        scheme.eval("(define (sum-ints n) (do ((i 0 (+ i 1)) (s 0 (+ s i))) ((= i n) s)))");
+        scheme.eval("(define (sum-floats n) (do ((i 0 (+ i 1)) (s 0.0 (- s (* 0.5 i)))) ((= i n) s)))");
+        scheme.eval("(define xs (vector 1 2.5))");
+        scheme.eval("(define (sum-mixed n) (do ((i 0 (+ i 1)) (s 0 (+ s (vector-ref xs (modulo i 2))))) ((= i n) s)))");
+        report(std::format("integer loop ({})", label).c_str(), ns_per_call(N, [&](std::size_t n) {
+            scheme.call("sum-ints", s7_int(n));
+        }));
+        report(std::format("float loop ({})", label).c_str(), ns_per_call(N, [&](std::size_t n) {
+            scheme.call("sum-floats", s7_int(n));
+        }));
+        report(std::format("mixed loop ({})", label).c_str(), ns_per_call(N, [&](std::size_t n) {
+            scheme.call("sum-mixed", s7_int(n));
+        }));
+        if (with_ops) {
+            scheme.eval("(define (sum-vec2 n) (do ((i 0 (+ i 1)) (s (vec2 0.0 0.0) (+ s (vec2 1.0 1.0)))) ((= i n) s)))");
+            report("vec2 + in a loop", ns_per_call(N / 10, [&](std::size_t n) {
+                scheme.call("sum-vec2", s7_int(n));
+            }));
+        }
+    };
+    run("no method ops", false);
+    run("with method ops", true);
+}
+
+// a property getter in a loop the optimizer compiles
+void bench_property()
+{
+    constexpr std::size_t N = 10'000'000;
+    s7::Scheme scheme;
+    scheme.make_usertype<vec2>("vec2", s7::Constructors("vec2", [](double x, double y) { return vec2 { x, y }; }));
+    scheme.define_property("vec2-x", "(vec2-x v) accesses x", [](const vec2 &v) { return v.x; }, [](vec2 &v, double x) { v.x = x; });
+    scheme.eval("(define (sum-x v n) (let ((s 0.0)) (do ((i 0 (+ i 1))) ((= i n) s) (set! s (+ s (vec2-x v))))))");
+    scheme.eval("(define v (vec2 1.0 2.0))");
+    report("(vec2-x v) in a loop", ns_per_call(N, [&](std::size_t n) {
+        scheme.call("sum-x", scheme.eval("v"), s7_int(n));
+    }));
+}
+
+// call vs call_checked on calls that succeed, and call_checked on one that
+// raises an error
+void bench_call_checked()
+{
+    constexpr std::size_t N = 1'000'000;
+    s7::Scheme scheme;
+    scheme.eval("(define (add a b) (+ a b))");
+    auto add = s7::Function(s7_name_to_value(scheme.ptr(), "add"));
+    report("call", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.call(add, s7_int(i), s7_int(1));
+        }
+    }));
+    report("call_checked", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.call_checked(add, s7_int(i), s7_int(1));
+        }
+    }));
+    report("call_checked (error)", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            scheme.call_checked(add, s7_int(i), s7_f(scheme.ptr()));
+        }
+    }));
+}
+
+// building 8 instances one after another vs SchemePool building them in
+// parallel, and the cost of a lease
+void bench_scheme_pool()
+{
+    constexpr std::size_t Instances = 8;
+    constexpr std::size_t N = 1'000'000;
+    auto setup = [](s7::Scheme &scheme) {
+        scheme.make_usertype<vec2>("vec2", s7::Constructors("vec2", [](double x, double y) { return vec2 { x, y }; }));
+        scheme.define_function("add", "(add a b) adds a and b", [](double a, double b) { return a + b; });
+        scheme.eval("(define (norm2 v) (+ (* (v 'x) (v 'x)) (* (v 'y) (v 'y))))");
+    };
+    report("instance setup, one at a time", ns_per_call(Instances, [&](std::size_t n) {
+        std::vector<std::unique_ptr<s7::Scheme>> schemes;
+        for (std::size_t i = 0; i < n; i++) {
+            setup(*schemes.emplace_back(std::make_unique<s7::Scheme>()));
+        }
+    }));
+    report("instance setup, SchemePool (8)", ns_per_call(Instances, [&](std::size_t n) {
+        s7::SchemePool pool(setup, { .size = n });
+    }));
+
+    s7::SchemePool pool(setup, { .size = Instances });
+    report("acquire + release", ns_per_call(N, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            auto scheme = pool.acquire();
+        }
+    }));
+}
+
+struct point {
+    double c[2];
+    double &operator[](std::size_t i) { return c[i]; }
+};
+
+// (p i) and (set! (p i) x) in a loop the optimizer compiles: with a type
+// whose elements are reals these go through unboxed getter/setter calls
+void bench_usertype_ref()
+{
+    constexpr std::size_t N = 10'000'000;
+    s7::Scheme scheme;
+    scheme.make_usertype<point>("point", s7::Constructors("point", [](double x, double y) { return point { { x, y } }; }));
+    scheme.eval("(define p (point 1.0 2.0))");
+    scheme.eval("(define (sum n) (let ((s 0.0)) (do ((i 0 (+ i 1))) ((= i n) s) (set! s (+ s (p 0) (p 1))))))");
+    scheme.eval("(define (bump! n) (do ((i 0 (+ i 1))) ((= i n) p) (set! (p 0) (+ (p 0) 1.0))))");
+    report("(p i) in a loop", ns_per_call(N, [&](std::size_t n) {
+        scheme.call("sum", s7_int(n));
+    }));
+    report("(set! (p i) x) in a loop", ns_per_call(N, [&](std::size_t n) {
+        scheme.call("bump!", s7_int(n));
+    }));
+}
+
+int main()
+{
+    bench_trampoline();
+    bench_static_binding();
+    bench_overload();
+    bench_prepared();
+    bench_map_into();
+    bench_compile_float();
+    bench_eval_columns();
+    bench_vector_interop();
+    bench_vector_conversion();
+    bench_containers();
+    bench_mdspan();
+    bench_call_borrowed();
+    bench_symbols();
+    bench_bound_variable();
+    bench_bind_variable();
+    bench_pool_allocator();
+    bench_object_creation();
+    bench_method_ops();
+    bench_usertype_ref();
+    bench_property();
+    bench_call_checked();
+    bench_scheme_pool();
+}
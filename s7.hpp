@@ -11,10 +11,27 @@
 #include <memory>
 #include <functional>
 #include <unordered_map>
-#include <unordered_set>
 #include <optional>
+#include <ranges>
 #include <utility>
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <exception>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <version>
+#ifdef __cpp_lib_expected
+#include <expected>
+#endif
 #include "function_traits.hpp"
 #include "s7/s7.h"
 #include "s7/s7-config.h"
@@ -88,13 +105,162 @@ public:
     s7_pointer ptr() const { return p; }
 };
 
+// doubles in malloc'd memory, which is the only kind s7 knows how to free:
+// moving a buffer into from() (or returning one from a function) hands the
+// memory to a float-vector without copying it
+class FloatBuffer {
+    double *p = nullptr;
+    std::size_t n = 0;
+
+public:
+    FloatBuffer() = default;
+    explicit FloatBuffer(std::size_t n) : p(static_cast<double *>(std::calloc(n, sizeof(double)))), n(n)
+    {
+        if (n != 0 && !p) {
+            throw std::bad_alloc();
+        }
+    }
+
+    FloatBuffer(const FloatBuffer &) = delete;
+    FloatBuffer & operator=(const FloatBuffer &) = delete;
+    FloatBuffer(FloatBuffer &&o) noexcept : p(std::exchange(o.p, nullptr)), n(std::exchange(o.n, 0)) {}
+    FloatBuffer & operator=(FloatBuffer &&o) noexcept { std::swap(p, o.p); std::swap(n, o.n); return *this; }
+    ~FloatBuffer() { std::free(p); }
+
+    double *data() { return p; }
+    const double *data() const { return p; }
+    std::size_t size() const { return n; }
+    double & operator[](std::size_t i) { return p[i]; }
+    double operator[](std::size_t i) const { return p[i]; }
+    double *begin() { return p; }
+    double *end() { return p + n; }
+    const double *begin() const { return p; }
+    const double *end() const { return p + n; }
+    std::span<double> span() { return std::span(p, n); }
+
+    // gives up the memory, which must then be released with free()
+    double *release() { n = 0; return std::exchange(p, nullptr); }
+};
+
+// a multidimensional view over row-major elements, the way s7 stores
+// (make-float-vector '(rows cols)) and friends: (v i j) in scheme is v(i, j)
+// here. T is double, s7_int or uint8_t for typed vectors, s7_pointer for
+// plain ones. as an argument it refers to the vector's storage directly.
+template <typename T, std::size_t Rank>
+class MdSpan {
+    T *p = nullptr;
+    std::array<std::size_t, Rank> exts = {};
+
+public:
+    using element_type = T;
+    static_assert(Rank > 0, "MdSpan needs at least one dimension");
+
+    MdSpan() = default;
+    MdSpan(T *data, std::array<std::size_t, Rank> extents) : p(data), exts(extents) {}
+
+    static constexpr std::size_t rank() { return Rank; }
+    std::size_t extent(std::size_t i) const { return exts[i]; }
+    const std::array<std::size_t, Rank> & extents() const { return exts; }
+    T *data() const { return p; }
+
+    std::size_t size() const
+    {
+        std::size_t n = 1;
+        for (auto e : exts) {
+            n *= e;
+        }
+        return n;
+    }
+
+    std::span<T> flat() const { return std::span(p, size()); }
+
+    template <typename... Is>
+        requires (sizeof...(Is) == Rank)
+    T & operator()(Is... is) const
+    {
+        std::size_t offset = 0, i = 0;
+        static_cast<void>(((offset = offset * exts[i++] + static_cast<std::size_t>(is)), ...));
+        return p[offset];
+    }
+};
+
+template <typename T>                      struct is_mdspan                  { static constexpr inline bool value = false; };
+template <typename T, std::size_t Rank>    struct is_mdspan<MdSpan<T, Rank>> { static constexpr inline bool value = true;  };
+template <typename T> constexpr bool is_mdspan_v = is_mdspan<std::remove_cvref_t<T>>::value;
+
+// a float-vector whose elements are C++ memory, made by Scheme::borrow().
+// the vector is only valid while the guard is alive: scripts must not keep
+// it (in a global, a closure...) past the guard's scope
+class BorrowedVector {
+    s7_scheme *sc;
+    s7_pointer vec;
+    s7_int loc;
+
+#if S7_DEBUGGING
+    // scheme may have stashed the wrapper somewhere. s7 has no call to
+    // shrink a vector, so its length and data pointer are found by value in
+    // the cell and cleared: a stashed wrapper is then empty (or crashes on a
+    // null pointer, if it has several dimensions) instead of reaching into
+    // memory that may be gone
+    static void poison(s7_pointer vec)
+    {
+        auto len  = s7_vector_length(vec);
+        auto data = s7_float_vector_elements(vec);
+        auto cell = reinterpret_cast<unsigned char *>(vec);
+        for (std::size_t off = sizeof(uint64_t); off <= 4 * sizeof(uint64_t); off += sizeof(uint64_t)) {
+            s7_int l;
+            s7_double *d;
+            std::memcpy(&l, cell + off, sizeof(l));
+            std::memcpy(&d, cell + off + sizeof(l), sizeof(d));
+            if (l == len && d == data) {
+                l = 0;
+                d = nullptr;
+                std::memcpy(cell + off, &l, sizeof(l));
+                std::memcpy(cell + off + sizeof(l), &d, sizeof(d));
+                return;
+            }
+        }
+    }
+#endif
+
+public:
+    BorrowedVector(s7_scheme *sc, std::span<double> data)
+        : sc(sc), vec(s7_make_float_vector_wrapper(sc, s7_int(data.size()), data.data(), 1, nullptr, false)),
+          loc(s7_gc_protect(sc, vec))
+    {}
+
+    // s7 copies the dimensions
+    BorrowedVector(s7_scheme *sc, std::span<double> data, std::span<s7_int> dims)
+        : sc(sc), vec(s7_make_float_vector_wrapper(sc, s7_int(data.size()), data.data(), s7_int(dims.size()), dims.data(), false)),
+          loc(s7_gc_protect(sc, vec))
+    {}
+
+    BorrowedVector(const BorrowedVector &) = delete;
+    BorrowedVector & operator=(const BorrowedVector &) = delete;
+    BorrowedVector(BorrowedVector &&o) noexcept
+        : sc(std::exchange(o.sc, nullptr)), vec(o.vec), loc(o.loc) {}
+    BorrowedVector & operator=(BorrowedVector &&) = delete;
+
+    ~BorrowedVector()
+    {
+        if (sc) {
+#if S7_DEBUGGING
+            poison(vec);
+#endif
+            s7_gc_unprotect_at(sc, loc);
+        }
+    }
+
+    s7_pointer ptr() const { return vec; }
+};
+
 class Function {
     s7_pointer p;
 
 public:
     Function(s7_pointer p) : p(p)
     {
-#ifdef S7_DEBUGGING
+#if S7_DEBUGGING
         assert(s7_is_procedure(p));
 #endif
     }
@@ -102,6 +268,12 @@ public:
     s7_pointer ptr() const { return p; }
 };
 
+template <typename Sig> class Callable;
+
+template <typename T>   struct is_callable                { static constexpr inline bool value = false; };
+template <typename Sig> struct is_callable<Callable<Sig>> { static constexpr inline bool value = true; };
+template <typename T> constexpr bool is_callable_v = is_callable<T>::value;
+
 class Let;
 
 class InputPort {
@@ -146,6 +318,22 @@ enum class OutputMode {
 struct FunctionOpts {
     bool unsafe_body = false;
     bool unsafe_arglist = false;
+    // overloads only: remember the signature that matched the last call and
+    // skip resolution when the next call has the same argument types
+    bool cache_overload = false;
+};
+
+// a named input column for eval_columns()
+struct Column {
+    std::string_view name;
+    std::span<const double> reals;
+    std::span<const s7_int> ints;
+    bool integer = false;
+
+    Column(std::string_view name, std::span<const double> data) : name(name), reals(data) {}
+    Column(std::string_view name, std::span<const s7_int> data) : name(name), ints(data), integer(true) {}
+
+    std::size_t size() const { return integer ? ints.size() : reals.size(); }
 };
 
 template <typename... Fns>
@@ -169,200 +357,1143 @@ struct Constructors<> {
     explicit Constructors(std::string_view name) : name(name) {}
 };
 
+template <std::size_t N>
+struct fixed_string {
+    char data[N] = {};
+
+    constexpr fixed_string(const char (&s)[N]) { std::copy_n(s, N, data); }
+    constexpr std::string_view view() const { return std::string_view(data, N - 1); }
+};
+
+// a symbol known at compile time, e.g. s7::sym<"on-tick">. anything that takes
+// a symbol name also takes one of these, and the symbol is only made once per
+// interpreter instead of being hashed into the symbol table on every access.
+template <fixed_string Name>
+struct Symbol {
+    static constexpr std::string_view name = Name.view();
+};
+
+template <fixed_string Name> inline constexpr Symbol<Name> sym = {};
+
 namespace detail {
+    // callables that don't capture anything don't need to be stored anywhere:
+    // a trampoline can just make its own
     template <typename L>
-    struct LambdaTable {
-        static inline std::function<typename FunctionTraits<L>::Signature> lambda;
+    constexpr bool is_stateless_v = std::is_empty_v<L> && std::is_default_constructible_v<L>;
+
+    template <typename L>
+    struct NameTable {
         static inline std::unordered_map<uintptr_t, std::string_view> name;
     };
 
-    template <typename F>
-    std::string_view get_lambda_name(s7_scheme *sc)
+    // the name a function was bound with. it's only used in error messages, so for
+    // stateless callables the lookup is only done when an error is actually raised.
+    struct Caller {
+        std::string_view name;
+        std::string_view (*lookup)(s7_scheme *sc) = nullptr;
+
+        Caller(std::string_view name) : name(name) {}
+        Caller(const char *name) : name(name) {}
+        explicit Caller(std::string_view (*lookup)(s7_scheme *sc)) : lookup(lookup) {}
+
+        std::string_view get(s7_scheme *sc) const { return lookup ? lookup(sc) : name; }
+    };
+
+    // the interpreter that a Scheme entry point (eval(), call(), ...) is
+    // running on this thread. fast paths aren't passed one, but need it to
+    // report an exception. depth counts the Entries on this thread's stack;
+    // each one restores it on the way out, so a longjmp past inner ones
+    // doesn't leave it off once the outermost returns. outermost counts
+    // the Entries made at depth 0.
+    struct Running {
+        static inline thread_local s7_scheme *sc = nullptr;
+        static inline thread_local unsigned depth = 0;
+        static inline thread_local std::uint64_t outermost = 0;
+    };
+
+    /*
+     * a C++ exception mustn't unwind through s7's frames: it's caught where s7
+     * called into C++ and raised again as a scheme error, which s7 unwinds the
+     * usual way (and which (catch ...) and call_checked() can see). calls that
+     * don't throw pay nothing for it.
+     */
+    struct CaughtException {
+        s7_pointer type;
+        s7_pointer info;
+    };
+
+    // only to be called from a catch block
+    inline CaughtException caught_exception(s7_scheme *sc, std::string_view caller)
     {
-        return LambdaTable<F>::name.find(reinterpret_cast<uintptr_t>(sc))->second;
+        const char *type = "c++-exception";
+        std::string what;
+        try {
+            throw;
+        } catch (const std::out_of_range &e) {
+            type = "out-of-range";
+            what = e.what();
+        } catch (const std::invalid_argument &e) {
+            type = "wrong-type-arg";
+            what = e.what();
+        } catch (const std::bad_alloc &e) {
+            type = "out-of-memory";
+            what = e.what();
+        } catch (const std::exception &e) {
+            what = e.what();
+        } catch (...) {
+            what = "unknown exception";
+        }
+        // the message goes through ~A, so that a ~ in it isn't taken as a directive
+        auto msg = std::format("{}: {}", caller, what);
+        auto fmt = s7_gc_protect_via_stack(sc, s7_make_string(sc, "~A"));
+        auto str = s7_gc_protect_via_stack(sc, s7_make_string_with_length(sc, msg.data(), msg.size()));
+        auto info = s7_list(sc, 2, fmt, str);
+        s7_gc_unprotect_via_stack(sc, str);
+        s7_gc_unprotect_via_stack(sc, fmt);
+        return { s7_make_symbol(sc, type), info };
     }
 
-    template <typename F>
-    void set_lambda(s7_scheme *sc, F &&f, std::string_view name)
+    // outside of the catch block, as s7_error() doesn't return
+    template <typename R>
+    R raise_exception(s7_scheme *sc, CaughtException e)
     {
-        LambdaTable<F>::lambda = std::move(f);
-        LambdaTable<F>::name.insert_or_assign(reinterpret_cast<uintptr_t>(sc), name.data());
+        if constexpr(std::is_same_v<R, s7_pointer>) {
+            return s7_error(sc, e.type, e.info);
+        } else {
+            s7_error(sc, e.type, e.info);
+            std::abort();
+        }
     }
 
-    template <typename T>
-    struct TypeTag {
-        static inline std::unordered_map<uintptr_t, s7_int> tag;
-        static inline std::unordered_map<uintptr_t, s7_pointer> let;
+    /*
+     * s7 doesn't give a c function any data of its own, so callables that do
+     * capture something get a slot in a fixed pool of trampolines, one pool
+     * per c signature. each slot is owned by the interpreter that registered
+     * it and released when that interpreter is destroyed.
+     *
+     * the pools are shared by every interpreter in the process: each one
+     * takes a slot per stored binding (plus one per fast path, see
+     * FastPathPool), so n interpreters with the same k bindings take n * k
+     * slots. S7_MAX_BINDINGS sets the size of a pool. every slot is a
+     * separate function, so a big pool costs compile time and code size for
+     * each signature. once a pool is full, functions are stored on their own
+     * instead (see StoredFunction); port functions and usertype ops need a c
+     * function, so for those it throws std::length_error.
+     *
+     * a pooled call goes through the slot's function pointer, so unlike the
+     * stateless case (captureless lambdas, define_function<&fn>) it can't be
+     * inlined into the trampoline.
+     */
+    struct BindingOwners {
+        static inline std::mutex mutex;
+        static inline std::unordered_map<uintptr_t, std::vector<std::pair<void (*)(std::size_t), std::size_t>>> owned;
+        // the c type of StoredFunction objects
+        static inline std::unordered_map<uintptr_t, s7_int> stored_tags;
     };
 
-    template <typename T>
-    s7_int get_type_tag(s7_scheme *sc)
+    // the table is written by interpreters being set up on other threads
+    template <typename L>
+    std::string_view get_lambda_name(s7_scheme *sc)
     {
-        auto &m = TypeTag<std::remove_cvref_t<T>>::tag;
-        auto it = m.find(reinterpret_cast<uintptr_t>(sc));
-#ifdef S7_DEBUGGING
-        assert(it != m.end() && "missing tag for T");
-#endif
-        return it->second;
+        std::lock_guard<std::mutex> lock(BindingOwners::mutex);
+        auto it = NameTable<L>::name.find(reinterpret_cast<uintptr_t>(sc));
+        return it != NameTable<L>::name.end() ? it->second : "a c function";
     }
 
-    template <typename T>
-    std::string_view get_type_name(s7_scheme *sc)
+    // the index of a free slot in a pool of size slots, or size if there's
+    // none. BindingOwners::mutex must be held
+    inline std::size_t take_slot(std::vector<std::size_t> &free_slots, std::size_t &next, std::size_t size)
     {
-        auto tag = get_type_tag<T>(sc);
-        auto ctypes = s7_let_field_ref(sc, s7_make_symbol(sc, "c-types"));
-        auto name = s7_list_ref(sc, ctypes, tag);
-        return std::string_view(s7_string(name), s7_string_length(name));
+        if (!free_slots.empty()) {
+            auto i = free_slots.back();
+            free_slots.pop_back();
+            return i;
+        }
+        return next < size ? next++ : size;
     }
 
-    template <typename T>
-    s7_pointer get_type_let(s7_scheme *sc)
-    {
-        auto &m = detail::TypeTag<std::remove_cvref_t<T>>::let;
-        auto it = m.find(reinterpret_cast<uintptr_t>(sc));
-#ifdef S7_DEBUGGING
-        assert(it != m.end() && "missing tag for T");
+    template <typename Sig, std::size_t Size> struct BindingPool;
+
+    template <typename R, typename... Args, std::size_t Size>
+    struct BindingPool<R(s7_scheme *, Args...), Size> {
+        using Fn = R (*)(s7_scheme *, Args...);
+
+        struct Slot {
+            void *data = nullptr;
+            R (*call)(void *data, std::string_view name, s7_scheme *sc, Args...) = nullptr;
+            void (*destroy)(void *data) = nullptr;
+            std::string_view name;
+        };
+
+        static inline std::array<Slot, Size> slots;
+        static inline std::vector<std::size_t> free_slots;
+        static inline std::size_t next = 0;
+
+        template <std::size_t N>
+        static R trampoline(s7_scheme *sc, Args... args)
+        {
+            auto &slot = slots[N];
+            CaughtException e;
+            try {
+                return slot.call(slot.data, slot.name, sc, args...);
+            } catch (...) {
+                e = caught_exception(sc, slot.name);
+            }
+            return raise_exception<R>(sc, e);
+        }
+
+        static constexpr auto trampolines = []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::array<Fn, Size> { &trampoline<Is>... };
+        }(std::make_index_sequence<Size>());
+
+        static void release(std::size_t i)
+        {
+            slots[i].destroy(slots[i].data);
+            slots[i] = Slot{};
+            free_slots.push_back(i);
+        }
+
+        // data is set to where fn is stored. returns nullptr, leaving fn
+        // alone, if the pool is full
+        template <typename L, typename Invoke>
+        static Fn bind(s7_scheme *sc, std::string_view name, L &fn, void **data)
+        {
+            std::lock_guard<std::mutex> lock(BindingOwners::mutex);
+            auto i = take_slot(free_slots, next, Size);
+            if (i == Size) {
+                return nullptr;
+            }
+            slots[i] = Slot {
+                .data    = new L(std::move(fn)),
+                .call    = [](void *data, std::string_view name, s7_scheme *sc, Args... args) -> R {
+                    return Invoke{}(*static_cast<L *>(data), Caller(name), sc, args...);
+                },
+                .destroy = [](void *data) { delete static_cast<L *>(data); },
+                .name    = name,
+            };
+            BindingOwners::owned[reinterpret_cast<uintptr_t>(sc)].push_back({ &release, i });
+            if (data) {
+                *data = slots[i].data;
+            }
+            return trampolines[i];
+        }
+
+        template <typename L, typename Invoke>
+        static R call_stateless(s7_scheme *sc, Args... args)
+        {
+            L fn{};
+            CaughtException e;
+            try {
+                return Invoke{}(fn, Caller(&get_lambda_name<L>), sc, args...);
+            } catch (...) {
+                e = caught_exception(sc, get_lambda_name<L>(sc));
+            }
+            return raise_exception<R>(sc, e);
+        }
+    };
+
+#ifndef S7_MAX_BINDINGS
+    #define S7_MAX_BINDINGS 128
 #endif
-        return it->second;
+
+    inline std::length_error out_of_bindings(std::size_t size)
+    {
+        return std::length_error(std::format("s7.hpp: out of slots for bound functions ({}), define S7_MAX_BINDINGS to raise it", size));
     }
 
-    template <typename T>
-    s7_pointer make_c_object(s7_scheme *sc, s7_int tag, T *p)
+    // returns a c function of signature Sig that calls Invoke{}(fn, caller, args...).
+    // data, if given, is set to where fn is stored (nullptr when it isn't)
+    template <typename Sig, std::size_t Size = S7_MAX_BINDINGS, typename L, typename Invoke>
+    auto bind_callable(s7_scheme *sc, std::string_view name, L &&fn, Invoke, void **data = nullptr)
     {
-        auto obj = s7_make_c_object(sc, tag, reinterpret_cast<void *>(p));
-        s7_c_object_set_let(sc, obj, s7_openlet(sc, get_type_let<T>(sc)));
-        return obj;
+        using Pool = BindingPool<Sig, Size>;
+        using Type = std::remove_cvref_t<L>;
+        if constexpr(is_stateless_v<Type>) {
+            std::lock_guard<std::mutex> lock(BindingOwners::mutex);
+            NameTable<Type>::name.insert_or_assign(reinterpret_cast<uintptr_t>(sc), name);
+            if (data) {
+                *data = nullptr;
+            }
+            return typename Pool::Fn(&Pool::template call_stateless<Type, Invoke>);
+        } else {
+            Type stored(std::move(fn));
+            auto f = Pool::template bind<Type, Invoke>(sc, name, stored, data);
+            if (!f) {
+                throw out_of_bindings(Size);
+            }
+            return f;
+        }
     }
 
-    template <typename R, typename... Args>
-    auto as_lambda(R (*fptr)(Args...))
+    /*
+     * the optimizer's fast paths (see FastPaths) get no s7_scheme * or
+     * function object to find a stored callable from, so for callables with
+     * state they're pooled the same way, one pool per fast path signature. a
+     * slot leads to the callable stored by the binding's BindingPool slot,
+     * and is released with it. a full pool isn't an error: the function just
+     * goes without that fast path.
+     */
+    struct FastPathTarget {
+        void *fn = nullptr;
+        std::string_view name;
+    };
+
+    template <typename Sig, std::size_t Size = S7_MAX_BINDINGS> struct FastPathPool;
+
+    template <typename R, typename... Args, std::size_t Size>
+    struct FastPathPool<R(Args...), Size> {
+        using Fn = R (*)(Args...);
+        using Call = R (*)(const FastPathTarget *target, Args...);
+
+        struct Slot {
+            FastPathTarget target;
+            Call call = nullptr;
+        };
+
+        static inline std::array<Slot, Size> slots;
+        static inline std::vector<std::size_t> free_slots;
+        static inline std::size_t next = 0;
+
+        template <std::size_t N>
+        static R trampoline(Args... args)
+        {
+            auto &slot = slots[N];
+            return slot.call(&slot.target, args...);
+        }
+
+        static constexpr auto trampolines = []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::array<Fn, Size> { &trampoline<Is>... };
+        }(std::make_index_sequence<Size>());
+
+        static void release(std::size_t i)
+        {
+            slots[i] = Slot{};
+            free_slots.push_back(i);
+        }
+
+        static Fn bind(s7_scheme *sc, FastPathTarget target, Call call)
+        {
+            std::lock_guard<std::mutex> lock(BindingOwners::mutex);
+            auto i = take_slot(free_slots, next, Size);
+            if (i == Size) {
+                return nullptr;
+            }
+            slots[i] = Slot { .target = target, .call = call };
+            BindingOwners::owned[reinterpret_cast<uintptr_t>(sc)].push_back({ &release, i });
+            return trampolines[i];
+        }
+    };
+
+    // a bound s7_function, and where its callable is stored, for the fast paths.
+    // fn is null if the callable went to a StoredFunction, which is in stored
+    // (protected at stored_loc until stored_value() uses it)
+    struct BoundFunction {
+        s7_function fn;
+        FastPathTarget target;
+        s7_pointer stored = nullptr;
+        s7_int stored_loc = 0;
+
+        operator s7_function() const { return fn; }
+
+        // for the places that can only take a c function
+        s7_function c_function() const
+        {
+            if (!fn) {
+                throw out_of_bindings(S7_MAX_BINDINGS);
+            }
+            return fn;
+        }
+    };
+
+    inline void release_bindings(s7_scheme *sc)
     {
-        return [=](Args... args) -> R { return fptr(args...); };
+        std::lock_guard<std::mutex> lock(BindingOwners::mutex);
+        BindingOwners::stored_tags.erase(reinterpret_cast<uintptr_t>(sc));
+        auto it = BindingOwners::owned.find(reinterpret_cast<uintptr_t>(sc));
+        if (it == BindingOwners::owned.end()) {
+            return;
+        }
+        for (auto [release, i] : it->second) {
+            release(i);
+        }
+        BindingOwners::owned.erase(it);
     }
 
-    template <typename C, typename R, typename... Args>
-    auto as_lambda(R (C::*fptr)(Args...))
+    /*
+     * per thread caches of per interpreter data (symbols, usertype info,
+     * bound variables) can't go by address alone, since a new interpreter may
+     * get the address of one that was destroyed. an interpreter is given a
+     * serial number the first time it's looked up, and the caches remember
+     * the serial they were filled for, so destroying one interpreter leaves
+     * what's cached for the others alone.
+     */
+    struct Instance {
+        // 0 once the interpreter is gone, until the Instance is reused
+        std::atomic<std::uint64_t> serial = 0;
+        // bumped by each Entry and each FloatExpr compile, see FloatExpr.
+        // only touched by the thread using the interpreter
+        std::uint64_t entries = 0;
+    };
+
+    struct InstanceId {
+        Instance *inst = nullptr;
+        std::uint64_t serial = 0;
+
+        bool live() const { return inst && inst->serial.load(std::memory_order_acquire) == serial; }
+    };
+
+    struct Instances {
+        static inline std::mutex mutex;
+        static inline std::uint64_t next_serial = 0;
+        // never freed, so a cache can always check the one it holds
+        static inline std::deque<Instance> all;
+        static inline std::vector<Instance *> unused;
+        static inline std::unordered_map<uintptr_t, Instance *> live;
+        // how many have ended, for the caches to notice what they can drop
+        static inline std::atomic<std::uint64_t> ended = 0;
+        static inline thread_local s7_scheme *last_sc = nullptr;
+        static inline thread_local InstanceId last;
+    };
+
+    inline InstanceId instance_id(s7_scheme *sc)
     {
-        return [=](C &c, Args... args) -> R { return ((&c)->*fptr)(args...); };
+        if (Instances::last_sc == sc && Instances::last.live()) {
+            return Instances::last;
+        }
+        std::lock_guard<std::mutex> lock(Instances::mutex);
+        auto &inst = Instances::live[reinterpret_cast<uintptr_t>(sc)];
+        if (!inst) {
+            if (Instances::unused.empty()) {
+                inst = &Instances::all.emplace_back();
+            } else {
+                inst = Instances::unused.back();
+                Instances::unused.pop_back();
+            }
+            inst->serial.store(++Instances::next_serial, std::memory_order_release);
+        }
+        Instances::last_sc = sc;
+        Instances::last = { inst, inst->serial.load(std::memory_order_relaxed) };
+        return Instances::last;
     }
 
-    template <typename C, typename R, typename... Args>
-    auto as_lambda(R (C::*fptr)(Args...) const)
+    // done by Scheme when it makes or destroys an interpreter
+    inline void end_instance(s7_scheme *sc)
     {
-        return [=](const C &c, Args... args) -> R { return ((&c)->*fptr)(args...); };
+        std::lock_guard<std::mutex> lock(Instances::mutex);
+        auto it = Instances::live.find(reinterpret_cast<uintptr_t>(sc));
+        if (it == Instances::live.end()) {
+            return;
+        }
+        it->second->serial.store(0, std::memory_order_release);
+        Instances::unused.push_back(it->second);
+        Instances::live.erase(it);
+        Instances::ended.fetch_add(1, std::memory_order_release);
     }
 
-    template <typename F>
-    auto as_lambda(F &&f)
+    /*
+     * symbols named with s7::sym<"..."> are made once per interpreter and then
+     * found by a per-name index. the table is per thread, so no locking is
+     * needed. (s7 never collects interned symbols, so entries can't go stale
+     * other than by the interpreter going away.)
+     */
+    struct SymbolTable {
+        s7_scheme *last_sc = nullptr;
+        InstanceId last_id;
+        std::vector<s7_pointer> *last = nullptr;
+        std::uint64_t ended = 0;
+        std::unordered_map<std::uint64_t, std::pair<InstanceId, std::vector<s7_pointer>>> symbols;
+    };
+
+    struct SymbolCache {
+        static inline std::atomic<std::size_t> next_id = 0;
+        static inline thread_local SymbolTable table;
+    };
+
+    inline std::vector<s7_pointer> &symbol_table(s7_scheme *sc)
     {
-        return f;
+        auto &t = SymbolCache::table;
+        if (t.last_sc == sc && t.last_id.live()) {
+            return *t.last;
+        }
+        auto id = instance_id(sc);
+        // drop the tables of interpreters that are gone
+        if (auto ended = Instances::ended.load(std::memory_order_acquire); t.ended != ended) {
+            std::erase_if(t.symbols, [](const auto &entry) { return !entry.second.first.live(); });
+            t.ended = ended;
+        }
+        auto &entry = t.symbols[id.serial];
+        entry.first = id;
+        t.last_sc = sc;
+        t.last_id = id;
+        t.last = &entry.second;
+        return *t.last;
     }
 
-    // (type-of p) that also works for c types
-    std::string_view type_of(s7_scheme *sc, s7_pointer p)
+    template <fixed_string Name>
+    s7_pointer symbol(s7_scheme *sc)
     {
-             if (s7_is_null(sc, p))        { return "null";            }
-        else if (p == s7_undefined(sc))    { return "undefined";       }
-        else if (s7_is_unspecified(sc, p)) { return "unspecified";     }
-        else if (s7_is_openlet(p))         { return "openlet";         }
-        else if (s7_is_let(p))             { return "let";             }
-        else if (s7_is_boolean(p))         { return "boolean";         }
-        else if (s7_is_integer(p))         { return "integer";         }
-        else if (s7_is_real(p))            { return "real";            }
-        else if (s7_is_string(p))          { return "string";          }
-        else if (s7_is_character(p))       { return "char";            }
-        else if (s7_is_ratio(p))           { return "rational";        }
-        else if (s7_is_complex(p))         { return "complex";         }
-        else if (s7_is_vector(p))          { return "vector";          }
-        else if (s7_is_int_vector(p))      { return "int-vector";      }
-        else if (s7_is_float_vector(p))    { return "float-vector";    }
-        else if (s7_is_byte_vector(p))     { return "byte-vector";     }
-        else if (s7_is_complex_vector(p))  { return "complex-vector";  }
-        else if (s7_is_pair(p))            { return "list";            }
-        else if (s7_is_c_pointer(p))       { return "c-pointer";       }
-        else if (s7_is_random_state(p))    { return "random-state";    }
-        else if (s7_is_hash_table(p))      { return "hash-table";      }
-        else if (s7_is_input_port(sc, p))  { return "input-port";      }
-        else if (s7_is_output_port(sc, p)) { return "output-port";     }
-        else if (s7_is_syntax(p))          { return "syntax";          }
-        else if (s7_is_symbol(p))          { return "symbol";          }
-        else if (s7_is_keyword(p))         { return "keyword";         }
-        else if (s7_is_procedure(p))       { return "procedure";       }
-        else if (s7_is_macro(sc, p))       { return "macro";           }
-        else if (s7_is_dilambda(p))        { return "dilambda";        }
-        else if (s7_is_multiple_value(p))  { return "values";          }
-        else if (s7_is_iterator(p))        { return "iterator";        }
-        else if (s7_is_bignum(p))          { return "bignum";          }
-        else if (s7_is_c_object(p)) {
-            auto ctypes = s7_let_field_ref(sc, s7_make_symbol(sc, "c-types"));
-            return s7_string(s7_list_ref(sc, ctypes, s7_c_object_type(p)));
-        } else {
-            return "unknown (should never happen)";
+        static const std::size_t id = SymbolCache::next_id++;
+        auto &syms = symbol_table(sc);
+        if (id >= syms.size()) {
+            syms.resize(id + 1, nullptr);
         }
+        if (!syms[id]) {
+            syms[id] = s7_make_symbol(sc, Name.data);
+        }
+        return syms[id];
     }
 
-    template <typename Tp, bool Output = false>
-    std::string_view type_to_string(s7_scheme *sc)
+    // the first datum in text, which needn't be null terminated
+    inline s7_pointer read_datum(s7_scheme *sc, std::string_view text)
     {
-        using T = std::decay_t<std::remove_cvref_t<Tp>>;
-             if constexpr(std::is_same_v<T, s7_pointer>)            { return "#t";         }
-        else if constexpr(std::is_same_v<T, void>)                  { return "unspecified"; }
-        else if constexpr(std::is_same_v<T, bool>)                  { return "boolean";     }
-        else if constexpr(std::is_same_v<T, s7_int>)                { return "integer";     }
-        else if constexpr(std::is_same_v<T, double>)                { return "real";        }
-        else if constexpr(std::is_same_v<T, s7_complex>)            { return "complex";     }
-        else if constexpr(std::is_same_v<T, const char *>
-                       || std::is_same_v<T, std::string_view>)      { return "string";      }
-        else if constexpr(std::is_same_v<T, unsigned char>)         { return "character";   }
-        else if constexpr(std::is_same_v<T, std::span<s7_pointer>>) { return "vector";      }
-        else if constexpr(std::is_same_v<T, std::span<s7_int>>)     { return "int-vector";   }
-        else if constexpr(std::is_same_v<T, std::span<double>>)     { return "float-vector"; }
-        else if constexpr(std::is_same_v<T, std::span<uint8_t>>)    { return "byte-vector";  }
-        else if constexpr(std::is_same_v<T, std::span<s7_complex>>) { return "complex-vector"; }
-        else if constexpr(std::is_pointer_v<T>)                     { return "c-pointer";    }
-        else if constexpr(std::is_same_v<T, List>)                  { return "list";        }
-        else if constexpr(std::is_same_v<T, Function>)              { return "procedure";   }
-        else if constexpr(std::is_same_v<T, Let>)                   { return "let"; }
-        else if constexpr(std::is_same_v<T, InputPort>)             { return "input-port"; }
-        else if constexpr(std::is_same_v<T, OutputPort>)            { return "output-port"; }
-        // allowed in to(), but with truncation
-        else if constexpr(std::is_same_v<T, int> || std::is_same_v<T, short> || std::is_same_v<T, long>) { return "integer"; }
-        else if constexpr(std::is_same_v<T, float>)                                                      { return "real"; }
-        // types that should only be in function return
-        else if constexpr(Output &&
-                         (std::is_same_v<T, std::vector<s7_int>>
-                       || std::is_same_v<T, std::span<int>>    || std::is_same_v<T, std::vector<int>>
-                       || std::is_same_v<T, std::span<short>>  || std::is_same_v<T, std::vector<short>>
-                       || std::is_same_v<T, std::span<long>>   || std::is_same_v<T, std::vector<long>>))    { return "int-vector";   }
-        else if constexpr(Output && std::is_same_v<T, std::string>)                                         { return "string";      }
-        else if constexpr(Output &&
-                         (std::is_same_v<T, std::vector<double>>
-                       || std::is_same_v<T, std::span<float>>  || std::is_same_v<T, std::vector<float>>))   { return "float-vector"; }
-        else if constexpr(Output && std::is_same_v<T, std::vector<uint8_t>>)                                { return "byte-vector";  }
-        else if constexpr(Output && std::is_same_v<T, std::vector<s7_complex>>)                             { return "complex-vector"; }
-        else if constexpr(Output && std::is_same_v<T, Values>)                                              { return "values";      }
-        // anything else
-        else                                                                                                { return detail::get_type_name<T>(sc); }
+        auto str = std::string(text);
+        auto port = s7_open_input_string(sc, str.c_str());
+        auto datum = s7_read(sc, port);
+        s7_close_input_port(sc, port);
+        return datum;
     }
 
-    template <typename T>
-    bool is(s7_scheme *sc, s7_pointer p)
+    // like symbol(), for other values the bindings make once per interpreter.
+    // make() must return something that stays alive on its own
+    template <fixed_string Name>
+    s7_pointer internal_value(s7_scheme *sc, auto &&make)
     {
-             if constexpr(std::is_same_v<T, s7_pointer>)            { return p;                     }
-        else if constexpr(std::is_same_v<T, bool>)                  { return s7_is_boolean(p);      }
-        else if constexpr(std::is_same_v<T, s7_int>)                { return s7_is_integer(p);      }
-        else if constexpr(std::is_same_v<T, double>)                { return s7_is_real(p);         }
-        else if constexpr(std::is_same_v<T, s7_complex>)            { return s7_is_complex(p);      }
-        else if constexpr(std::is_same_v<T, const char *>
-                       || std::is_same_v<T, std::string_view>)      { return s7_is_string(p);       }
-        else if constexpr(std::is_same_v<T, unsigned char>)         { return s7_is_character(p);    }
-        else if constexpr(std::is_same_v<T, std::span<s7_pointer>>) { return s7_is_vector(p);       }
+        static const std::size_t id = SymbolCache::next_id++;
+        auto &vals = symbol_table(sc);
+        if (id >= vals.size()) {
+            vals.resize(id + 1, nullptr);
+        }
+        if (!vals[id]) {
+            vals[id] = make();
+        }
+        return vals[id];
+    }
+
+    /*
+     * C++ variables bound with Scheme::bind_variable. s7 can't compute a
+     * variable's value when it's read, so each one is copied into its slot
+     * whenever control enters scheme, and again whenever a bound function
+     * returns to it, since that's the only other time C++ code runs (only
+     * if it changed, so an unchanged double doesn't allocate). a setter on
+     * the symbol writes set! through to the C++ side right away.
+     */
+    struct LiveField {
+        s7_pointer sym;
+        s7_pointer slot;
+        void *field;
+        void (*push)(s7_scheme *sc, s7_pointer slot, void *field);
+        bool (*pull)(s7_scheme *sc, void *field, s7_pointer value);
+        std::string_view type;
+    };
+
+    // the list of an interpreter is found through a per thread cache like
+    // TypeTag's, so entering scheme takes no lock. the map's nodes don't
+    // move, and only the interpreter's own thread adds to its list.
+    struct LiveFieldsCache {
+        std::uint64_t serial = 0;
+        std::uint64_t generation = 0;
+        std::vector<LiveField> *fields = nullptr;
+    };
+
+    struct LiveFields {
+        static inline std::mutex mutex;
+        // by address, with the serial of the interpreter the list belongs to
+        static inline std::unordered_map<uintptr_t, std::pair<std::uint64_t, std::vector<LiveField>>> fields;
+        // bumped when an interpreter gets its first field, for caches holding nullptr
+        static inline std::atomic<std::uint64_t> generation = 0;
+        static inline thread_local LiveFieldsCache cache;
+    };
+
+    // nullptr if sc has no bound variables
+    inline std::vector<LiveField> *find_live_fields(s7_scheme *sc)
+    {
+        auto &c = LiveFields::cache;
+        auto serial = instance_id(sc).serial;
+        auto gen = LiveFields::generation.load(std::memory_order_acquire);
+        if (c.serial != serial || c.generation != gen) {
+            std::lock_guard<std::mutex> lock(LiveFields::mutex);
+            auto it = LiveFields::fields.find(reinterpret_cast<uintptr_t>(sc));
+            auto found = it != LiveFields::fields.end() && it->second.first == serial;
+            c = { serial, gen, found ? &it->second.second : nullptr };
+        }
+        return c.fields;
+    }
+
+    inline void add_live_field(s7_scheme *sc, LiveField field)
+    {
+        auto serial = instance_id(sc).serial;
+        bool first;
+        {
+            std::lock_guard<std::mutex> lock(LiveFields::mutex);
+            auto [it, inserted] = LiveFields::fields.try_emplace(reinterpret_cast<uintptr_t>(sc));
+            // left behind by an interpreter that wasn't made by Scheme
+            if (!inserted && it->second.first != serial) {
+                it->second.second.clear();
+                inserted = true;
+            }
+            it->second.first = serial;
+            it->second.second.push_back(field);
+            first = inserted;
+        }
+        // caches may hold nullptr for sc
+        if (first) {
+            LiveFields::generation.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    inline void push_live_fields(s7_scheme *sc)
+    {
+        if (auto fields = find_live_fields(sc); fields) {
+            for (const auto &f : *fields) {
+                f.push(sc, f.slot, f.field);
+            }
+        }
+    }
+
+    // runs the body of a bound function, then copies bound variables in, so
+    // scheme sees what it changed as soon as it returns. that's before the
+    // result is boxed, which an allocation here could otherwise collect.
+    // sc is null for direct calls from C++ (see DirectCall)
+    decltype(auto) sync_after(s7_scheme *sc, auto &&body)
+    {
+        if constexpr(std::is_void_v<decltype(body())>) {
+            body();
+            if (sc) {
+                push_live_fields(sc);
+            }
+        } else {
+            decltype(auto) res = body();
+            if (sc) {
+                push_live_fields(sc);
+            }
+            return res;
+        }
+    }
+
+    // done on the way into the interpreter by eval(), call(), apply(), ...
+    struct Entry {
+        s7_scheme *prev;
+        unsigned prev_depth;
+
+        explicit Entry(s7_scheme *sc) : prev(Running::sc), prev_depth(Running::depth)
+        {
+            Running::sc = sc;
+            if (Running::depth++ == 0) {
+                Running::outermost++;
+            }
+            instance_id(sc).inst->entries++;
+            push_live_fields(sc);
+        }
+
+        ~Entry()
+        {
+            Running::sc = prev;
+            Running::depth = prev_depth;
+        }
+
+        Entry(const Entry &) = delete;
+        Entry & operator=(const Entry &) = delete;
+    };
+
+    // around calls from C++ straight into a fast path or code compiled by
+    // s7_float_optimize: there's no evaluation to raise a scheme error in,
+    // so an exception is left to reach the caller
+    struct DirectCall {
+        s7_scheme *prev = std::exchange(Running::sc, nullptr);
+
+        DirectCall() = default;
+        ~DirectCall() { Running::sc = prev; }
+
+        DirectCall(const DirectCall &) = delete;
+        DirectCall & operator=(const DirectCall &) = delete;
+    };
+
+    struct TypeInfo {
+        s7_int tag;
+        s7_pointer let;
+        // only set when make_usertype was given an allocation policy other than new/delete
+        void *(*allocate)() = nullptr;
+        void (*deallocate)(void *p) = nullptr;
+        // set once the type has method ops, see open_type_objects
+        bool open = false;
+    };
+
+    // the last lookup is cached per thread, so that making objects of a type
+    // doesn't need a map lookup every time
+    template <typename T>
+    struct TypeTag {
+        struct Cache {
+            std::uint64_t serial = 0;
+            std::uint64_t generation = 0;
+            const TypeInfo *info = nullptr;
+        };
+
+        static inline std::mutex mutex;
+        // by address, with the serial of the interpreter the type was added to
+        static inline std::unordered_map<uintptr_t, std::pair<std::uint64_t, TypeInfo>> info;
+        // bumped when the type is added to an interpreter, for caches holding nullptr
+        static inline std::atomic<std::uint64_t> generation = 0;
+        static inline thread_local Cache cache;
+    };
+
+    template <typename T>
+    const TypeInfo *find_type_info(s7_scheme *sc)
+    {
+        using Tag = TypeTag<std::remove_cvref_t<T>>;
+        auto &c = Tag::cache;
+        auto serial = instance_id(sc).serial;
+        auto gen = Tag::generation.load(std::memory_order_acquire);
+        if (c.serial != serial || c.generation != gen) {
+            std::lock_guard<std::mutex> lock(Tag::mutex);
+            auto it = Tag::info.find(reinterpret_cast<uintptr_t>(sc));
+            auto found = it != Tag::info.end() && it->second.first == serial;
+            c = { serial, gen, found ? &it->second.second : nullptr };
+        }
+        return c.info;
+    }
+
+    template <typename T>
+    void set_type_info(s7_scheme *sc, TypeInfo info)
+    {
+        using Tag = TypeTag<std::remove_cvref_t<T>>;
+        {
+            std::lock_guard<std::mutex> lock(Tag::mutex);
+            Tag::info.insert_or_assign(reinterpret_cast<uintptr_t>(sc), std::pair(instance_id(sc).serial, info));
+        }
+        Tag::generation.fetch_add(1, std::memory_order_release);
+    }
+
+    template <typename T>
+    const TypeInfo &get_type_info(s7_scheme *sc)
+    {
+        auto info = find_type_info<T>(sc);
+#if S7_DEBUGGING
+        assert(info && "missing tag for T");
+#endif
+        return *info;
+    }
+
+    template <typename T>
+    s7_int get_type_tag(s7_scheme *sc)
+    {
+        return get_type_info<T>(sc).tag;
+    }
+
+    template <typename T>
+    bool has_type_tag(s7_scheme *sc)
+    {
+        return find_type_info<T>(sc) != nullptr;
+    }
+
+    template <typename T>
+    std::string_view get_type_name(s7_scheme *sc)
+    {
+        auto tag = get_type_tag<T>(sc);
+        auto ctypes = s7_let_field_ref(sc, symbol<"c-types">(sc));
+        auto name = s7_list_ref(sc, ctypes, tag);
+        return std::string_view(s7_string(name), s7_string_length(name));
+    }
+
+    template <typename T>
+    s7_pointer get_type_let(s7_scheme *sc)
+    {
+        return get_type_info<T>(sc).let;
+    }
+
+    // a new T, allocated the way make_usertype was told to
+    template <typename T, typename... Args>
+    T *construct(const TypeInfo &info, Args&&... args)
+    {
+        if (!info.allocate) {
+            return new T(FWD(args)...);
+        }
+        void *mem = info.allocate();
+        try {
+            return new (mem) T(FWD(args)...);
+        } catch (...) {
+            info.deallocate(mem);
+            throw;
+        }
+    }
+
+    // the let holding a type's methods is shared by all its objects (and was
+    // opened once by make_usertype)
+    inline s7_pointer wrap_c_object(s7_scheme *sc, const TypeInfo &info, s7_int tag, void *p)
+    {
+        auto obj = s7_make_c_object_with_let(sc, tag, p, info.let);
+        return info.open ? s7_openlet(sc, obj) : obj;
+    }
+
+    // p must come from new. the object is freed the way make_usertype was
+    // told to, so for another allocation policy it's moved into memory of
+    // that policy first
+    template <typename T>
+    s7_pointer make_c_object(s7_scheme *sc, s7_int tag, T *p)
+    {
+        const auto &info = get_type_info<T>(sc);
+        if (info.allocate) {
+            std::unique_ptr<T> owned(p);
+            if constexpr(std::is_move_constructible_v<T>) {
+                p = construct<T>(info, std::move(*owned));
+            } else {
+                throw std::invalid_argument("make_c_object: the type is pooled and can't be moved, use new_c_object");
+            }
+        }
+        return wrap_c_object(sc, info, tag, p);
+    }
+
+    // a new T in a new c-object
+    template <typename T, typename... Args>
+    s7_pointer new_c_object(s7_scheme *sc, Args&&... args)
+    {
+        const auto &info = get_type_info<T>(sc);
+        return wrap_c_object(sc, info, info.tag, construct<T>(info, FWD(args)...));
+    }
+
+    template <typename R, typename... Args>
+    auto as_lambda(R (*fptr)(Args...))
+    {
+        return [=](Args... args) -> R { return fptr(args...); };
+    }
+
+    template <typename C, typename R, typename... Args>
+    auto as_lambda(R (C::*fptr)(Args...))
+    {
+        return [=](C &c, Args... args) -> R { return ((&c)->*fptr)(args...); };
+    }
+
+    template <typename C, typename R, typename... Args>
+    auto as_lambda(R (C::*fptr)(Args...) const)
+    {
+        return [=](const C &c, Args... args) -> R { return ((&c)->*fptr)(args...); };
+    }
+
+    template <typename F>
+    auto as_lambda(F &&f)
+    {
+        return f;
+    }
+
+    // the operator[] that (obj i) uses: T's only one, or the non-const one when
+    // there's also a const overload (only that one matches non_const_index)
+    template <typename T, typename R, typename A>
+    constexpr auto non_const_index(R (T::*f)(A)) { return f; }
+
+    template <typename T>
+    concept has_index_operator = requires { &T::operator[]; } || requires { non_const_index<T>(&T::operator[]); };
+
+    template <typename T>
+    constexpr auto index_operator()
+    {
+        if constexpr(requires { &T::operator[]; }) { return &T::operator[]; }
+        else                                        { return non_const_index<T>(&T::operator[]); }
+    }
+
+    // indexes are often size_t, which isn't one of the integer types to() knows
+    template <typename T>
+    using index_arg_t = std::conditional_t<std::is_same_v<std::remove_cvref_t<T>, std::size_t>, s7_int, T>;
+
+    // a function pointer known at compile time, as a lambda that captures
+    // nothing: it gets a trampoline of its own, with the call inlined into it
+    template <auto Fn, typename R, typename... Args>
+    auto as_stateless(R (*)(Args...))
+    {
+        return [](Args... args) -> R { return Fn(FWD(args)...); };
+    }
+
+    template <auto Fn, typename C, typename R, typename... Args>
+    auto as_stateless(R (C::*)(Args...))
+    {
+        return [](C &c, Args... args) -> R { return (c.*Fn)(FWD(args)...); };
+    }
+
+    template <auto Fn, typename C, typename R, typename... Args>
+    auto as_stateless(R (C::*)(Args...) const)
+    {
+        return [](const C &c, Args... args) -> R { return (c.*Fn)(FWD(args)...); };
+    }
+
+    // (type-of p) that also works for c types
+    std::string_view type_of(s7_scheme *sc, s7_pointer p)
+    {
+             if (s7_is_null(sc, p))        { return "null";            }
+        else if (p == s7_undefined(sc))    { return "undefined";       }
+        else if (s7_is_unspecified(sc, p)) { return "unspecified";     }
+        else if (s7_is_openlet(p))         { return "openlet";         }
+        else if (s7_is_let(p))             { return "let";             }
+        else if (s7_is_boolean(p))         { return "boolean";         }
+        else if (s7_is_integer(p))         { return "integer";         }
+        else if (s7_is_real(p))            { return "real";            }
+        else if (s7_is_string(p))          { return "string";          }
+        else if (s7_is_character(p))       { return "char";            }
+        else if (s7_is_ratio(p))           { return "rational";        }
+        else if (s7_is_complex(p))         { return "complex";         }
+        else if (s7_is_vector(p))          { return "vector";          }
+        else if (s7_is_int_vector(p))      { return "int-vector";      }
+        else if (s7_is_float_vector(p))    { return "float-vector";    }
+        else if (s7_is_byte_vector(p))     { return "byte-vector";     }
+        else if (s7_is_complex_vector(p))  { return "complex-vector";  }
+        else if (s7_is_pair(p))            { return "list";            }
+        else if (s7_is_c_pointer(p))       { return "c-pointer";       }
+        else if (s7_is_random_state(p))    { return "random-state";    }
+        else if (s7_is_hash_table(p))      { return "hash-table";      }
+        else if (s7_is_input_port(sc, p))  { return "input-port";      }
+        else if (s7_is_output_port(sc, p)) { return "output-port";     }
+        else if (s7_is_syntax(p))          { return "syntax";          }
+        else if (s7_is_symbol(p))          { return "symbol";          }
+        else if (s7_is_keyword(p))         { return "keyword";         }
+        else if (s7_is_procedure(p))       { return "procedure";       }
+        else if (s7_is_macro(sc, p))       { return "macro";           }
+        else if (s7_is_dilambda(p))        { return "dilambda";        }
+        else if (s7_is_multiple_value(p))  { return "values";          }
+        else if (s7_is_iterator(p))        { return "iterator";        }
+        else if (s7_is_bignum(p))          { return "bignum";          }
+        else if (s7_is_c_object(p)) {
+            auto ctypes = s7_let_field_ref(sc, symbol<"c-types">(sc));
+            return s7_string(s7_list_ref(sc, ctypes, s7_c_object_type(p)));
+        } else {
+            return "unknown (should never happen)";
+        }
+    }
+
+    // owning vectors that to() fills from an s7 vector's storage, widening or
+    // narrowing each element (from() does the same in the other direction)
+    template <typename T, typename U = std::remove_cvref_t<T>>
+    constexpr bool is_int_vector_copy_v   = std::is_same_v<U, std::vector<s7_int>> || std::is_same_v<U, std::vector<int>>
+                                         || std::is_same_v<U, std::vector<short>>  || std::is_same_v<U, std::vector<long>>;
+    template <typename T, typename U = std::remove_cvref_t<T>>
+    constexpr bool is_float_vector_copy_v = std::is_same_v<U, std::vector<double>> || std::is_same_v<U, std::vector<float>>;
+    template <typename T, typename U = std::remove_cvref_t<T>>
+    constexpr bool is_byte_vector_copy_v  = std::is_same_v<U, std::vector<uint8_t>>;
+
+    template <typename T>             struct is_optional                   { static constexpr inline bool value = false; };
+    template <typename T>             struct is_optional<std::optional<T>> { static constexpr inline bool value = true;  };
+    template <typename T>             struct is_tuple                      { static constexpr inline bool value = false; };
+    template <typename... Ts>         struct is_tuple<std::tuple<Ts...>>   { static constexpr inline bool value = true;  };
+    template <typename A, typename B> struct is_tuple<std::pair<A, B>>     { static constexpr inline bool value = true;  };
+
+    // containers marshalled element by element: optionals are the value or
+    // #f, tuples and pairs are lists, maps are hash-tables and any other
+    // container is a vector (or a list, when converting from scheme). a
+    // container registered as a usertype stays a c-object.
+    template <typename T> constexpr bool is_optional_v = is_optional<std::remove_cvref_t<T>>::value;
+    template <typename T> constexpr bool is_tuple_v    = is_tuple<std::remove_cvref_t<T>>::value;
+    template <typename T> constexpr bool is_map_v      = requires(std::remove_cvref_t<T> &c) {
+        typename std::remove_cvref_t<T>::key_type;
+        typename std::remove_cvref_t<T>::mapped_type;
+        c.begin();
+    };
+    template <typename T> constexpr bool is_set_v      = !is_map_v<T> && requires(std::remove_cvref_t<T> &c, typename std::remove_cvref_t<T>::key_type k) {
+        c.insert(k);
+    };
+    template <typename T> constexpr bool is_sequence_v = !std::is_same_v<std::remove_cvref_t<T>, std::string>
+                                                      && requires(std::remove_cvref_t<T> &c, typename std::remove_cvref_t<T>::value_type v) {
+        c.push_back(v);
+    };
+
+    // whether is<T>() looks at the elements (or the shape), so that the
+    // class of a value isn't enough to tell if it converts
+    template <typename T>
+    constexpr bool checks_elements()
+    {
+        if constexpr(is_optional_v<T>) {
+            return checks_elements<typename std::remove_cvref_t<T>::value_type>();
+        } else {
+            return is_tuple_v<T> || is_map_v<T> || is_set_v<T> || is_sequence_v<T> || is_mdspan_v<T>;
+        }
+    }
+
+    // the vector type holding elements of type E, for MdSpan
+    template <typename E>
+    bool is_vector_of(s7_pointer p)
+    {
+             if constexpr(std::is_same_v<E, double>)  { return s7_is_float_vector(p); }
+        else if constexpr(std::is_same_v<E, s7_int>)  { return s7_is_int_vector(p);   }
+        else if constexpr(std::is_same_v<E, uint8_t>) { return s7_is_byte_vector(p);  }
+        else {
+            static_assert(std::is_same_v<E, s7_pointer>, "MdSpan elements must be double, s7_int, uint8_t or s7_pointer");
+            return s7_is_vector(p) && !s7_is_float_vector(p) && !s7_is_int_vector(p)
+                && !s7_is_byte_vector(p) && !s7_is_complex_vector(p);
+        }
+    }
+
+    template <typename E>
+    E *vector_elements(s7_pointer p)
+    {
+             if constexpr(std::is_same_v<E, double>)  { return s7_float_vector_elements(p); }
+        else if constexpr(std::is_same_v<E, s7_int>)  { return s7_int_vector_elements(p);   }
+        else if constexpr(std::is_same_v<E, uint8_t>) { return s7_byte_vector_elements(p);  }
+        else                                          { return s7_vector_elements(p);       }
+    }
+
+    template <typename E>
+    s7_pointer make_vector_of(s7_scheme *sc, s7_int len, s7_int rank, s7_int *dims)
+    {
+             if constexpr(std::is_same_v<E, double>)  { return s7_make_float_vector(sc, len, rank, dims);  }
+        else if constexpr(std::is_same_v<E, s7_int>)  { return s7_make_int_vector(sc, len, rank, dims);    }
+        else if constexpr(std::is_same_v<E, uint8_t>) { return s7_make_byte_vector(sc, len, rank, dims);   }
+        else                                          { return s7_make_normal_vector(sc, len, rank, dims); }
+    }
+
+    template <typename E, std::size_t Rank>
+    std::array<s7_int, Rank> mdspan_dims(const MdSpan<E, Rank> &m)
+    {
+        std::array<s7_int, Rank> dims;
+        for (std::size_t i = 0; i < Rank; i++) {
+            dims[i] = s7_int(m.extent(i));
+        }
+        return dims;
+    }
+
+    // to() builds these by value, so const & and && parameters of these
+    // types bind to the converted temporary
+    template <typename T>
+    using arg_type = std::conditional_t<(std::is_same_v<std::remove_cvref_t<T>, std::string>
+                                      || is_int_vector_copy_v<T> || is_float_vector_copy_v<T> || is_byte_vector_copy_v<T>
+                                      || is_optional_v<T> || checks_elements<T>())
+                                     && (std::is_rvalue_reference_v<T> || std::is_const_v<std::remove_reference_t<T>>),
+                                        std::remove_cvref_t<T>, T>;
+
+    // calls f on each element of a list or vector until it returns false.
+    // elements of numeric vectors are boxed
+    inline bool every_element(s7_scheme *sc, s7_pointer p, auto &&f)
+    {
+        if (s7_is_vector(p)) {
+            for (s7_int i = 0, n = s7_vector_length(p); i < n; i++) {
+                if (!f(s7_vector_ref(sc, p, i))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        for (; s7_is_pair(p); p = s7_cdr(p)) {
+            if (!f(s7_car(p))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // calls f on the key and value of each entry of a hash-table until it returns false
+    inline bool every_entry(s7_scheme *sc, s7_pointer table, auto &&f)
+    {
+        auto iter = s7_gc_protect_via_stack(sc, s7_make_iterator(sc, table));
+        auto ok = true;
+        for (auto e = s7_iterate(sc, iter); ok && e != s7_eof_object(sc); e = s7_iterate(sc, iter)) {
+            ok = f(s7_car(e), s7_cdr(e));
+        }
+        s7_gc_unprotect_via_stack(sc, iter);
+        return ok;
+    }
+
+    template <typename Tp, bool Output = false>
+    std::string_view type_to_string(s7_scheme *sc)
+    {
+        using T = std::decay_t<std::remove_cvref_t<Tp>>;
+             if constexpr(std::is_same_v<T, s7_pointer>)            { return "#t";         }
+        else if constexpr(std::is_same_v<T, void>)                  { return "unspecified"; }
+        else if constexpr(std::is_same_v<T, bool>)                  { return "boolean";     }
+        else if constexpr(std::is_same_v<T, s7_int>)                { return "integer";     }
+        else if constexpr(std::is_same_v<T, double>)                { return "real";        }
+        else if constexpr(std::is_same_v<T, s7_complex>)            { return "complex";     }
+        else if constexpr(std::is_same_v<T, const char *>
+                       || std::is_same_v<T, std::string_view>)      { return "string";      }
+        else if constexpr(std::is_same_v<T, unsigned char>)         { return "character";   }
+        else if constexpr(std::is_same_v<T, std::span<s7_pointer>>) { return "vector";      }
+        else if constexpr(std::is_same_v<T, std::span<s7_int>>)     { return "int-vector";   }
+        else if constexpr(std::is_same_v<T, std::span<double>>)     { return "float-vector"; }
+        else if constexpr(std::is_same_v<T, std::span<uint8_t>>)    { return "byte-vector";  }
+        else if constexpr(std::is_same_v<T, std::span<s7_complex>>) { return "complex-vector"; }
+        else if constexpr(is_int_vector_copy_v<T>)                  { return "int-vector";   }
+        else if constexpr(is_float_vector_copy_v<T>)                { return "float-vector"; }
+        else if constexpr(is_byte_vector_copy_v<T>)                 { return "byte-vector";  }
+        else if constexpr(std::is_same_v<T, std::string>)           { return "string";       }
+        else if constexpr(is_optional_v<T>)                         { return type_to_string<typename T::value_type, Output>(sc); }
+        else if constexpr(is_tuple_v<T>)                            { return "list";         }
+        else if constexpr(is_map_v<T>)                              { return "hash-table";   }
+        else if constexpr(is_set_v<T> || is_sequence_v<T>)          { return "sequence";     }
+        else if constexpr(is_mdspan_v<T>) {
+            using E = std::remove_const_t<typename T::element_type>;
+            return std::is_same_v<E, double> ? "float-vector" : std::is_same_v<E, s7_int>  ? "int-vector"
+                 : std::is_same_v<E, uint8_t> ? "byte-vector" : "vector";
+        }
+        else if constexpr(std::is_pointer_v<T>)                     { return "c-pointer";    }
+        else if constexpr(std::is_same_v<T, List>)                  { return "list";        }
+        else if constexpr(std::is_same_v<T, Function>
+                       || is_callable_v<T>)                         { return "procedure";   }
+        else if constexpr(std::is_same_v<T, Let>)                   { return "let"; }
+        else if constexpr(std::is_same_v<T, InputPort>)             { return "input-port"; }
+        else if constexpr(std::is_same_v<T, OutputPort>)            { return "output-port"; }
+        // allowed in to(), but with truncation
+        else if constexpr(std::is_same_v<T, int> || std::is_same_v<T, short> || std::is_same_v<T, long>) { return "integer"; }
+        else if constexpr(std::is_same_v<T, float>)                                                      { return "real"; }
+        // types that should only be in function return
+        else if constexpr(Output &&
+                         (std::is_same_v<T, std::span<int>>    || std::is_same_v<T, std::span<short>>
+                       || std::is_same_v<T, std::span<long>>))                                              { return "int-vector";   }
+        else if constexpr(Output && std::is_same_v<T, std::span<float>>)                                    { return "float-vector"; }
+        else if constexpr(Output && std::is_same_v<T, FloatBuffer>)                                         { return "float-vector"; }
+        else if constexpr(Output && std::is_same_v<T, std::vector<s7_complex>>)                             { return "complex-vector"; }
+        else if constexpr(Output && std::is_same_v<T, Values>)                                              { return "values";      }
+        // anything else
+        else                                                                                                { return detail::get_type_name<T>(sc); }
+    }
+
+    template <typename T>
+    bool is(s7_scheme *sc, s7_pointer p)
+    {
+             if constexpr(std::is_same_v<T, s7_pointer>)            { return p;                     }
+        else if constexpr(std::is_same_v<T, bool>)                  { return s7_is_boolean(p);      }
+        else if constexpr(std::is_same_v<T, s7_int>)                { return s7_is_integer(p);      }
+        else if constexpr(std::is_same_v<T, double>)                { return s7_is_real(p);         }
+        else if constexpr(std::is_same_v<T, s7_complex>)            { return s7_is_complex(p);      }
+        else if constexpr(std::is_same_v<T, const char *>
+                       || std::is_same_v<T, std::string_view>)      { return s7_is_string(p);       }
+        else if constexpr(std::is_same_v<T, unsigned char>)         { return s7_is_character(p);    }
+        else if constexpr(std::is_same_v<T, std::span<s7_pointer>>) { return s7_is_vector(p);       }
         else if constexpr(std::is_same_v<T, std::span<s7_int>>)     { return s7_is_int_vector(p);   }
         else if constexpr(std::is_same_v<T, std::span<double>>)     { return s7_is_float_vector(p); }
         else if constexpr(std::is_same_v<T, std::span<uint8_t>>)    { return s7_is_byte_vector(p);  }
+        else if constexpr(is_int_vector_copy_v<T>)                  { return s7_is_int_vector(p);   }
+        else if constexpr(is_float_vector_copy_v<T>)                { return s7_is_float_vector(p); }
+        else if constexpr(is_byte_vector_copy_v<T>)                 { return s7_is_byte_vector(p);  }
+        else if constexpr(std::is_same_v<std::remove_cvref_t<T>, std::string>) { return s7_is_string(p); }
+        else if constexpr(is_mdspan_v<T>) {
+            using U = std::remove_cvref_t<T>;
+            return is_vector_of<std::remove_const_t<typename U::element_type>>(p) && s7_vector_rank(p) == s7_int(U::rank());
+        } else if constexpr(is_optional_v<T>) {
+            return p == s7_f(sc) || is<typename std::remove_cvref_t<T>::value_type>(sc, p);
+        } else if constexpr(is_tuple_v<T>) {
+            using U = std::remove_cvref_t<T>;
+            if (!s7_is_list(sc, p) || s7_list_length(sc, p) != s7_int(std::tuple_size_v<U>)) {
+                return false;
+            }
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return ((is<std::tuple_element_t<Is, U>>(sc, s7_list_ref(sc, p, Is))) && ...);
+            }(std::make_index_sequence<std::tuple_size_v<U>>());
+        } else if constexpr(is_map_v<T> || is_set_v<T> || is_sequence_v<T>) {
+            using U = std::remove_cvref_t<T>;
+            if (s7_is_c_object(p)) {
+                return has_type_tag<U>(sc) && s7_c_object_type(p) == get_type_tag<U>(sc);
+            }
+            if constexpr(is_map_v<T>) {
+                return s7_is_hash_table(p) && every_entry(sc, p, [&](s7_pointer k, s7_pointer v) {
+                    return is<typename U::key_type>(sc, k) && is<typename U::mapped_type>(sc, v);
+                });
+            } else {
+                if (!s7_is_vector(p) && !s7_is_list(sc, p)) {
+                    return false;
+                }
+                // numeric vectors hold one type, their first element decides
+                auto homogeneous = s7_is_int_vector(p) || s7_is_float_vector(p) || s7_is_byte_vector(p);
+                return homogeneous ? s7_vector_length(p) == 0 || is<typename U::value_type>(sc, s7_vector_ref(sc, p, 0))
+                                   : every_element(sc, p, [&](s7_pointer e) { return is<typename U::value_type>(sc, e); });
+            }
+        }
         else if constexpr(std::is_pointer_v<T>)                     { return s7_is_c_pointer(p);    }
         else if constexpr(std::is_same_v<T, List>)                  { return s7_is_pair(p);         }
         else if constexpr(std::is_same_v<T, Function>)              { return s7_is_procedure(p);    }
+        else if constexpr(is_callable_v<T>)                         { return s7_is_procedure(p);    }
         else if constexpr(std::is_same_v<T, Let>)                   { return s7_is_let(p);          }
         else if constexpr(std::is_same_v<T, InputPort>)             { return s7_is_input_port(sc, p);  }
         else if constexpr(std::is_same_v<T, OutputPort>)            { return s7_is_output_port(sc, p); }
@@ -376,7 +1507,7 @@ namespace detail {
     template <typename T>
     T to(s7_scheme *sc, s7_pointer p)
     {
-#ifdef S7_DEBUGGING
+#if S7_DEBUGGING
         assert(is<T>(sc, p) && "p isn't an object of type T");
 #endif
              if constexpr(std::is_same_v<T, s7_pointer>)            { return p;                                                                 }
@@ -385,7 +1516,7 @@ namespace detail {
         else if constexpr(std::is_same_v<T, double>)                { return s7_real(p);                                                        }
         else if constexpr(std::is_same_v<T, s7_complex>)            { return s7_complex(s7_real_part(p), s7_imag_part(p));                      }
         else if constexpr(std::is_same_v<T, const char *>)          { return s7_string(p);                                                      }
-        else if constexpr(std::is_same_v<T, std::string_view>)      { return std::string_view(s7_string(p));                                    }
+        else if constexpr(std::is_same_v<T, std::string_view>)      { return std::string_view(s7_string(p), s7_string_length(p));               }
         else if constexpr(std::is_same_v<T, char>)                  { return static_cast<char>(s7_character(p));                                }
         else if constexpr(std::is_same_v<T, std::span<s7_pointer>>) { return std::span(s7_vector_elements(p), s7_vector_length(p));             }
         else if constexpr(std::is_same_v<T, std::span<s7_int>>)     { return std::span(s7_int_vector_elements(p), s7_vector_length(p));         }
@@ -394,6 +1525,7 @@ namespace detail {
         else if constexpr(std::is_pointer_v<T>)                     { return reinterpret_cast<T>(s7_c_pointer(p));                              }
         else if constexpr(std::is_same_v<T, List>)                  { return List(p);                                                           }
         else if constexpr(std::is_same_v<T, Function>)              { return Function(p);                                                       }
+        else if constexpr(is_callable_v<T>)                         { return T(sc, Function(p));                                                }
         else if constexpr(std::is_same_v<T, Let>)                   { return Let(sc, p);                                                        }
         else if constexpr(std::is_same_v<T, InputPort>)             { return InputPort(sc, p);   }
         else if constexpr(std::is_same_v<T, OutputPort>)            { return OutputPort(sc, p);   }
@@ -405,10 +1537,73 @@ namespace detail {
             WARN_PRINT(";converting double to float\n");
             return static_cast<T>(s7_real(p));
         }
+        else if constexpr(is_int_vector_copy_v<T>) {
+            auto elems = s7_int_vector_elements(p);
+            return T(elems, elems + s7_vector_length(p));
+        }
+        else if constexpr(is_float_vector_copy_v<T>) {
+            auto elems = s7_float_vector_elements(p);
+            return T(elems, elems + s7_vector_length(p));
+        }
+        else if constexpr(is_byte_vector_copy_v<T>) {
+            auto elems = s7_byte_vector_elements(p);
+            return T(elems, elems + s7_vector_length(p));
+        }
+        else if constexpr(std::is_same_v<T, std::string>) {
+            return std::string(s7_string(p), s7_string_length(p));
+        }
+        else if constexpr(is_mdspan_v<T>) {
+            std::array<s7_int, T::rank()> dims;
+            s7_vector_dimensions(p, dims.data(), s7_int(T::rank()));
+            std::array<std::size_t, T::rank()> extents;
+            std::copy(dims.begin(), dims.end(), extents.begin());
+            return T(vector_elements<std::remove_const_t<typename T::element_type>>(p), extents);
+        }
+        else if constexpr(is_optional_v<T>) {
+            using V = typename T::value_type;
+            return is<V>(sc, p) ? T(to<V>(sc, p)) : std::nullopt;
+        }
+        else if constexpr(is_tuple_v<T>) {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                std::array<s7_pointer, std::tuple_size_v<T>> elems;
+                for (auto &e : elems) {
+                    e = s7_car(p);
+                    p = s7_cdr(p);
+                }
+                return T(to<std::tuple_element_t<Is, T>>(sc, elems[Is])...);
+            }(std::make_index_sequence<std::tuple_size_v<T>>());
+        }
+        else if constexpr(is_map_v<T> || is_set_v<T> || is_sequence_v<T>) {
+            if (s7_is_c_object(p)) {
+                return *reinterpret_cast<T *>(s7_c_object_value(p));
+            }
+            T c;
+            if constexpr(is_map_v<T>) {
+                every_entry(sc, p, [&](s7_pointer k, s7_pointer v) {
+                    c.emplace(to<typename T::key_type>(sc, k), to<typename T::mapped_type>(sc, v));
+                    return true;
+                });
+            } else {
+                if constexpr(requires { c.reserve(std::size_t(0)); }) {
+                    c.reserve(std::size_t(s7_is_vector(p) ? s7_vector_length(p) : s7_list_length(sc, p)));
+                }
+                every_element(sc, p, [&](s7_pointer e) {
+                    if constexpr(is_set_v<T>) {
+                        c.insert(to<typename T::value_type>(sc, e));
+                    } else {
+                        c.push_back(to<typename T::value_type>(sc, e));
+                    }
+                    return true;
+                });
+            }
+            return c;
+        }
         else                                                        { return *reinterpret_cast<std::remove_cvref_t<T> *>(s7_c_object_value(p)); }
     }
 
     template <typename F> Function make_function(s7_scheme *sc, std::string_view name, std::string_view doc, F &&func, FunctionOpts opts = {});
+    template <typename T> s7_pointer from_tuple(s7_scheme *sc, const T &t);
+    template <typename T> s7_pointer from_container(s7_scheme *sc, T &c);
 
     template <typename T>
     s7_pointer from(s7_scheme *sc, const T &x)
@@ -427,10 +1622,12 @@ namespace detail {
         else if constexpr(std::is_same_v<Type, unsigned char>)                                   { return s7_make_character(sc, x);                            }
         else if constexpr(std::is_same_v<Type, List>)                                            { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, Function>)                                        { return x.ptr();                                             }
+        else if constexpr(is_callable_v<Type>)                                                   { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, Let>)                                             { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, Values>)                                          { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, InputPort>)                                       { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, OutputPort>)                                      { return x.ptr();                                             }
+        else if constexpr(std::is_same_v<Type, BorrowedVector>)                                  { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, std::span<s7_pointer>> || std::is_same_v<Type, std::vector<s7_pointer>>) {
             auto vec = s7_make_vector(sc, x.size());
             for (size_t i = 0; i < x.size(); i++) {
@@ -442,22 +1639,20 @@ namespace detail {
                          || std::is_same_v<Type, std::span<short>>  || std::is_same_v<Type, std::vector<short>>
                          || std::is_same_v<Type, std::span<long>>   || std::is_same_v<Type, std::vector<long>>) {
             auto vec = s7_make_int_vector(sc, x.size(), 1, nullptr);
-            for (size_t i = 0; i < x.size(); i++) {
-                s7_int_vector_set(vec, i, x[i]);
-            }
+            std::copy(x.begin(), x.end(), s7_int_vector_elements(vec));
             return vec;
         } else if constexpr(std::is_same_v<Type, std::span<double>> || std::is_same_v<Type, std::vector<double>>
                          || std::is_same_v<Type, std::span<float>>  || std::is_same_v<Type, std::vector<float>>) {
             auto vec = s7_make_float_vector(sc, x.size(), 1, nullptr);
-            for (size_t i = 0; i < x.size(); i++) {
-                s7_float_vector_set(vec, i, x[i]);
-            }
+            std::copy(x.begin(), x.end(), s7_float_vector_elements(vec));
+            return vec;
+        } else if constexpr(std::is_same_v<Type, FloatBuffer>) {
+            auto vec = s7_make_float_vector(sc, x.size(), 1, nullptr);
+            std::copy(x.begin(), x.end(), s7_float_vector_elements(vec));
             return vec;
         } else if constexpr(std::is_same_v<Type, std::span<uint8_t>> || std::is_same_v<Type, std::vector<uint8_t>>) {
             auto vec = s7_make_byte_vector(sc, x.size(), 1, nullptr);
-            for (size_t i = 0; i < x.size(); i++) {
-                s7_byte_vector_set(vec, i, x[i]);
-            }
+            std::copy(x.begin(), x.end(), s7_byte_vector_elements(vec));
             return vec;
         } else if constexpr(std::is_function_v<std::remove_cvref_t<T>>
                   || std::is_function_v<std::remove_pointer_t<T>>
@@ -465,9 +1660,24 @@ namespace detail {
             return make_function(sc, "anonymous", "generated by from()", x, {}).ptr();
         } else if constexpr(std::is_pointer_v<Type>) {
             return s7_make_c_pointer(sc, x);
+        } else if constexpr(is_mdspan_v<Type>) {
+            using E = std::remove_const_t<typename Type::element_type>;
+            auto dims = mdspan_dims(x);
+            auto vec = make_vector_of<E>(sc, s7_int(x.size()), s7_int(Type::rank()), dims.data());
+            std::copy(x.data(), x.data() + x.size(), vector_elements<E>(vec));
+            return vec;
+        } else if constexpr(is_optional_v<Type>) {
+            return x.has_value() ? from(sc, *x) : s7_f(sc);
+        } else if constexpr(is_tuple_v<Type>) {
+            return from_tuple(sc, x);
+        } else if constexpr(is_map_v<Type> || std::ranges::forward_range<const Type>) {
+            if (!has_type_tag<Type>(sc)) {
+                return from_container(sc, x);
+            }
+            return detail::new_c_object<Type>(sc, x);
         } else {
             using Type = std::remove_cvref_t<Type>;
-            return detail::make_c_object(sc, detail::get_type_tag<Type>(sc), new Type(x));
+            return detail::new_c_object<Type>(sc, x);
         }
     }
 
@@ -488,10 +1698,12 @@ namespace detail {
         else if constexpr(std::is_same_v<Type, unsigned char>)                                   { return s7_make_character(sc, x);                            }
         else if constexpr(std::is_same_v<Type, List>)                                            { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, Function>)                                        { return x.ptr();                                             }
+        else if constexpr(is_callable_v<Type>)                                                   { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, Let>)                                             { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, Values>)                                          { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, InputPort>)                                       { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, OutputPort>)                                      { return x.ptr();                                             }
+        else if constexpr(std::is_same_v<Type, BorrowedVector>)                                  { return x.ptr();                                             }
         else if constexpr(std::is_same_v<Type, std::span<s7_pointer>> || std::is_same_v<Type, std::vector<s7_pointer>>) {
             auto vec = s7_make_vector(sc, x.size());
             for (size_t i = 0; i < x.size(); i++) {
@@ -503,60 +1715,271 @@ namespace detail {
                          || std::is_same_v<Type, std::span<short>>  || std::is_same_v<Type, std::vector<short>>
                          || std::is_same_v<Type, std::span<long>>   || std::is_same_v<Type, std::vector<long>>) {
             auto vec = s7_make_int_vector(sc, x.size(), 1, nullptr);
-            for (size_t i = 0; i < x.size(); i++) {
-                s7_int_vector_set(vec, i, x[i]);
-            }
+            std::copy(x.begin(), x.end(), s7_int_vector_elements(vec));
             return vec;
         } else if constexpr(std::is_same_v<Type, std::span<double>> || std::is_same_v<Type, std::vector<double>>
                          || std::is_same_v<Type, std::span<float>>  || std::is_same_v<Type, std::vector<float>>) {
             auto vec = s7_make_float_vector(sc, x.size(), 1, nullptr);
-            for (size_t i = 0; i < x.size(); i++) {
-                s7_float_vector_set(vec, i, x[i]);
-            }
+            std::copy(x.begin(), x.end(), s7_float_vector_elements(vec));
             return vec;
+        } else if constexpr(std::is_same_v<Type, FloatBuffer>) {
+            if constexpr(std::is_lvalue_reference_v<T>) {
+                auto vec = s7_make_float_vector(sc, x.size(), 1, nullptr);
+                std::copy(x.begin(), x.end(), s7_float_vector_elements(vec));
+                return vec;
+            } else {
+                auto n = s7_int(x.size());
+                return s7_make_float_vector_wrapper(sc, n, x.release(), 1, nullptr, true);
+            }
         } else if constexpr(std::is_same_v<Type, std::span<uint8_t>> || std::is_same_v<Type, std::vector<uint8_t>>) {
             auto vec = s7_make_byte_vector(sc, x.size(), 1, nullptr);
-            for (size_t i = 0; i < x.size(); i++) {
-                s7_byte_vector_set(vec, i, x[i]);
-            }
+            std::copy(x.begin(), x.end(), s7_byte_vector_elements(vec));
             return vec;
         } else if constexpr(std::is_function_v<std::remove_cvref_t<T>>
                   || std::is_function_v<std::remove_pointer_t<T>>
                   || requires { T::operator(); }) {
-            return make_function(sc, "anonymous", "generated by from()", std::move(x), {}).ptr();
+            return make_function(sc, "anonymous", "generated by from()", FWD(x), {}).ptr();
         } else if constexpr(std::is_pointer_v<Type>) {
             return s7_make_c_pointer(sc, x);
+        } else if constexpr(is_mdspan_v<Type>) {
+            using E = std::remove_const_t<typename Type::element_type>;
+            auto dims = mdspan_dims(x);
+            auto vec = make_vector_of<E>(sc, s7_int(x.size()), s7_int(Type::rank()), dims.data());
+            std::copy(x.data(), x.data() + x.size(), vector_elements<E>(vec));
+            return vec;
+        } else if constexpr(is_optional_v<Type>) {
+            return x.has_value() ? from(sc, *x) : s7_f(sc);
+        } else if constexpr(is_tuple_v<Type>) {
+            return from_tuple(sc, x);
+        } else if constexpr(is_map_v<Type> || std::ranges::forward_range<std::remove_reference_t<T> &>) {
+            if (!has_type_tag<Type>(sc)) {
+                return from_container(sc, x);
+            }
+            return detail::new_c_object<Type>(sc, FWD(x));
         } else {
             using Type = std::remove_cvref_t<Type>;
-            return detail::make_c_object(sc, detail::get_type_tag<Type>(sc), new Type(std::move(x)));
+            return detail::new_c_object<Type>(sc, FWD(x));
+        }
+    }
+
+    // s7 hands out string wrappers from a ring of 8
+    constexpr std::size_t max_borrowed_strings = 8;
+
+    template <typename T>
+    constexpr bool is_borrowable_string_v = std::is_same_v<std::remove_cvref_t<T>, std::string>
+                                         || std::is_same_v<std::remove_cvref_t<T>, std::string_view>
+                                         || std::is_same_v<std::decay_t<std::remove_cvref_t<T>>, const char *>
+                                         || std::is_same_v<std::decay_t<std::remove_cvref_t<T>>, char *>;
+
+    // arguments for Scheme::call_borrowed(): strings are wrapped, the rest goes through from()
+    template <typename T>
+    s7_pointer borrow_arg(s7_scheme *sc, T &&x)
+    {
+        using Type = std::remove_cvref_t<T>;
+        if constexpr(std::is_same_v<Type, std::string> || std::is_same_v<Type, std::string_view>) {
+            return s7_make_string_wrapper_with_length(sc, x.data(), s7_int(x.size()));
+        } else if constexpr(is_borrowable_string_v<T>) {
+            return s7_make_string_wrapper(sc, x);
+        } else {
+            return from(sc, FWD(x));
+        }
+    }
+
+    template <typename T>
+    s7_pointer from_tuple(s7_scheme *sc, const T &t)
+    {
+        auto list = s7_gc_protect_via_stack(sc, s7_make_list(sc, s7_int(std::tuple_size_v<T>), s7_f(sc)));
+        auto p = list;
+        std::apply([&](const auto &...elems) {
+            ((s7_set_car(p, from(sc, elems)), p = s7_cdr(p)), ...);
+        }, t);
+        s7_gc_unprotect_via_stack(sc, list);
+        return list;
+    }
+
+    // numbers go to int/float/byte-vectors in one copy, anything else is
+    // converted one element at a time into a vector of the right size
+    template <typename T>
+    s7_pointer from_container(s7_scheme *sc, T &c)
+    {
+        if constexpr(is_map_v<T>) {
+            auto table = s7_gc_protect_via_stack(sc, s7_make_hash_table(sc, s7_int(c.size())));
+            for (const auto &[k, v] : c) {
+                auto key = s7_gc_protect_via_stack(sc, from(sc, k));
+                s7_hash_table_set(sc, table, key, from(sc, v));
+                s7_gc_unprotect_via_stack(sc, key);
+            }
+            s7_gc_unprotect_via_stack(sc, table);
+            return table;
+        } else {
+            using V = std::ranges::range_value_t<T>;
+            auto n = s7_int(std::ranges::distance(c));
+            if constexpr(std::is_same_v<V, uint8_t>) {
+                auto vec = s7_make_byte_vector(sc, n, 1, nullptr);
+                std::ranges::copy(c, s7_byte_vector_elements(vec));
+                return vec;
+            } else if constexpr(std::is_integral_v<V> && !std::is_same_v<V, bool> && !std::is_same_v<V, char>) {
+                auto vec = s7_make_int_vector(sc, n, 1, nullptr);
+                std::ranges::copy(c, s7_int_vector_elements(vec));
+                return vec;
+            } else if constexpr(std::is_floating_point_v<V>) {
+                auto vec = s7_make_float_vector(sc, n, 1, nullptr);
+                std::ranges::copy(c, s7_float_vector_elements(vec));
+                return vec;
+            } else {
+                auto vec = s7_gc_protect_via_stack(sc, s7_make_vector(sc, n));
+                s7_int i = 0;
+                for (auto &&e : c) {
+                    // proxies (std::vector<bool>) are converted to the value type first
+                    if constexpr(std::is_same_v<std::remove_cvref_t<decltype(e)>, V>) {
+                        s7_vector_set(sc, vec, i++, from(sc, std::as_const(e)));
+                    } else {
+                        s7_vector_set(sc, vec, i++, from(sc, V(e)));
+                    }
+                }
+                s7_gc_unprotect_via_stack(sc, vec);
+                return vec;
+            }
+        }
+    }
+
+    constexpr auto vmin(auto a) { return a; }
+    constexpr auto vmin(auto a, auto &&...args) { return std::min(a, vmin(args...)); }
+    constexpr auto vmax(auto a) { return a; }
+    constexpr auto vmax(auto a, auto &&...args) { return std::max(a, vmax(args...)); }
+    template <typename... Fns> constexpr auto max_arity() { return vmax(FunctionTraits<Fns>::arity...); }
+    template <typename... Fns> constexpr auto min_arity() { return vmin(FunctionTraits<Fns>::arity...); }
+
+    const char *input_mode_to_string(InputMode m) { return m == InputMode::Read ? "r" : ""; }
+    const char *output_mode_to_string(OutputMode m) { return m == OutputMode::Write ? "w" : "a"; }
+
+    inline constexpr std::size_t cache_line = 64;
+
+    // power of two sizes up to a cache line, so that no object straddles two
+    // lines; anything bigger takes whole lines
+    constexpr std::size_t size_class(std::size_t size, std::size_t align)
+    {
+        auto n = std::max({ size, align, sizeof(void *) });
+        return n <= cache_line ? std::bit_ceil(n) : (n + cache_line - 1) / cache_line * cache_line;
+    }
+
+    /*
+     * fixed size blocks carved out of cache line aligned slabs, shared by every
+     * type of the same size class. each thread has its own free list, so no
+     * locking is needed except when taking a new slab; a block freed on another
+     * thread just joins that thread's list. slabs are never given back (they
+     * stay reachable from the list below), so blocks left on the list of a
+     * thread that exits are never used again: a program that frees objects
+     * on short lived threads should expect that memory to stay taken.
+     */
+    template <std::size_t Size, std::size_t SlabSize>
+    struct SlabPool {
+        static_assert(SlabSize % cache_line == 0 && SlabSize / Size >= 8, "slabs are too small for this size class");
+
+        struct Block {
+            Block *next;
+        };
+
+        static inline std::mutex mutex;
+        static inline std::vector<void *> slabs;
+        static inline thread_local Block *free_list = nullptr;
+
+        static void *allocate()
+        {
+            if (!free_list) {
+                refill();
+            }
+            auto b = free_list;
+            free_list = b->next;
+            return b;
+        }
+
+        static void deallocate(void *p)
+        {
+            auto b = static_cast<Block *>(p);
+            b->next = free_list;
+            free_list = b;
+        }
+
+        static void refill()
+        {
+            auto slab = static_cast<char *>(::operator new(SlabSize, std::align_val_t(cache_line)));
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slabs.push_back(slab);
+            }
+            // pushed back to front, so that blocks are handed out in address order
+            for (std::size_t i = SlabSize / Size; i-- > 0; ) {
+                deallocate(slab + i * Size);
+            }
         }
+    };
+
+    template <typename T>
+    struct PoolCounters {
+        static inline std::atomic<std::size_t> live = 0;
+        static inline std::atomic<std::size_t> peak = 0;
+    };
+} // namespace detail
+
+/*
+ * allocation policies for usertype objects, chosen with make_usertype's second
+ * template argument, e.g. make_usertype<v2, s7::PoolAllocator<>>("v2", ...).
+ * NewDelete is the default. PoolAllocator takes objects from per size class
+ * slabs (see detail::SlabPool) and keeps a count of live objects per type.
+ */
+struct NewDelete {};
+
+struct PoolStats {
+    std::size_t live;
+    std::size_t peak;
+};
+
+template <std::size_t SlabSize = 64 * 1024>
+struct PoolAllocator {
+    template <typename T>
+    using Pool = detail::SlabPool<detail::size_class(sizeof(T), alignof(T)), SlabSize>;
+
+    template <typename T>
+    static void *allocate()
+    {
+        static_assert(alignof(T) <= detail::cache_line, "over-aligned types can't be pooled");
+        auto p = Pool<T>::allocate();
+        auto live = ++detail::PoolCounters<T>::live;
+        auto peak = detail::PoolCounters<T>::peak.load(std::memory_order_relaxed);
+        while (live > peak && !detail::PoolCounters<T>::peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+        return p;
     }
 
-    constexpr auto vmin(auto a) { return a; }
-    constexpr auto vmin(auto a, auto &&...args) { return std::min(a, vmin(args...)); }
-    constexpr auto vmax(auto a) { return a; }
-    constexpr auto vmax(auto a, auto &&...args) { return std::max(a, vmin(args...)); }
-    template <typename... Fns> constexpr auto max_arity() { return vmax(FunctionTraits<Fns>::arity...); }
-    template <typename... Fns> constexpr auto min_arity() { return vmin(FunctionTraits<Fns>::arity...); }
+    template <typename T>
+    static void deallocate(void *p)
+    {
+        Pool<T>::deallocate(p);
+        --detail::PoolCounters<T>::live;
+    }
 
-    const char *input_mode_to_string(InputMode m) { return m == InputMode::Read ? "r" : ""; }
-    const char *output_mode_to_string(OutputMode m) { return m == OutputMode::Write ? "w" : "a"; }
-} // namespace detail
+    template <typename T>
+    static PoolStats stats()
+    {
+        return { detail::PoolCounters<T>::live.load(), detail::PoolCounters<T>::peak.load() };
+    }
+};
 
 template <typename T>
 struct VarArgs {
     s7_scheme *sc;
     s7_pointer p;
-    std::string_view caller;
+    detail::Caller caller;
     s7_int arg_n;
 
 public:
     using Type = T;
 
-    VarArgs(s7_scheme *sc, s7_pointer p, std::string_view caller)
+    VarArgs(s7_scheme *sc, s7_pointer p, detail::Caller caller)
         : sc(sc), p(p), caller(caller), arg_n(1) {}
 
-    VarArgs(s7_scheme *sc, s7_pointer p, std::string_view caller, s7_int arg_n)
+    VarArgs(s7_scheme *sc, s7_pointer p, detail::Caller caller, s7_int arg_n)
         : sc(sc), p(p), caller(caller), arg_n(arg_n) {}
 
     T convert(s7_pointer x) const
@@ -564,12 +1987,12 @@ public:
         if constexpr(std::is_same_v<T, s7_pointer>) {
             return x;
         } else {
-#ifdef S7_DEBUGGING
+#if S7_DEBUGGING
             if (!detail::is<T>(sc, x)) {
                 // this is actually fine, since s7_wrong_type_arg_error is a
                 // noreturn function (despite not marked as such)
                 auto s = std::format("a {}", detail::type_to_string<T>(sc));
-                return detail::to<T>(sc, s7_wrong_type_arg_error(sc, caller.data(), arg_n, x, s.c_str()));
+                return detail::to<T>(sc, s7_wrong_type_arg_error(sc, caller.get(sc).data(), arg_n, x, s.c_str()));
             }
 #endif
             return detail::to<T>(sc, x);
@@ -651,8 +2074,25 @@ namespace detail {
 
     template <typename F> s7_pointer make_signature(s7_scheme *sc, F &&) { return make_signature<F>(sc); }
 
+    // converts already checked arguments and boxes the result
+    template <typename R, typename... Args>
+    s7_pointer invoke_fn(s7_scheme *sc, const s7_pointer *arr, auto &&fn)
+    {
+        auto body = [&] {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) -> decltype(auto) {
+                return fn(detail::to<arg_type<Args>>(sc, arr[Is])...);
+            }(std::index_sequence_for<Args...>());
+        };
+        if constexpr(std::is_same_v<R, void>) {
+            sync_after(sc, body);
+            return s7_unspecified(sc);
+        } else {
+            return detail::from(sc, sync_after(sc, body));
+        }
+    }
+
     template <typename R, typename... Args>
-    s7_pointer call_fn(s7_scheme *sc, s7_pointer args, auto &&fn, std::string_view name)
+    s7_pointer call_fn(s7_scheme *sc, s7_pointer args, auto &&fn, [[maybe_unused]] Caller name)
     {
         constexpr auto NumArgs = sizeof...(Args);
         auto arglist = List(args);
@@ -661,7 +2101,7 @@ namespace detail {
             arr[i] = arglist.advance();
         }
 
-#ifdef S7_DEBUGGING
+#if S7_DEBUGGING
         auto bools = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
             return std::array<bool, NumArgs> { detail::is<Args>(sc, arr[Is])...  };
         }(std::make_index_sequence<NumArgs>());
@@ -674,148 +2114,807 @@ namespace detail {
             auto types = std::array<std::string_view, NumArgs> {
                 f(detail::type_to_string<Args>(sc))...
             };
-            return s7_wrong_type_arg_error(sc, name.data(), i+1, arglist[i], types[i].data());
+            return s7_wrong_type_arg_error(sc, name.get(sc).data(), i+1, arglist[i], types[i].data());
         }
 #endif
 
+        return invoke_fn<R, Args...>(sc, arr.data(), fn);
+    }
+
+    template <typename R, typename T>
+    s7_pointer call_varargs_fn(s7_scheme *sc, s7_pointer args, auto &&fn, Caller name)
+    {
+        auto body = [&]() -> decltype(auto) { return fn(VarArgs<T>(sc, args, name)); };
         if constexpr(std::is_same_v<R, void>) {
-            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-                fn(detail::to<Args>(sc, arr[Is])...);
-            }(std::make_index_sequence<NumArgs>());
+            sync_after(sc, body);
             return s7_unspecified(sc);
         } else {
-            return detail::from(sc, [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-                return fn(detail::to<Args>(sc, arr[Is])...);
-            }(std::make_index_sequence<NumArgs>()));
+            return detail::from(sc, sync_after(sc, body));
         }
     }
 
-    template <typename R, typename T>
-    s7_pointer call_varargs_fn(s7_scheme *sc, s7_pointer args, auto &&fn, std::string_view name)
+    template <typename F>
+    s7_pointer call_bound_fn(s7_scheme *sc, s7_pointer args, auto &fn, Caller name)
     {
-        if constexpr(std::is_same_v<R, void>) {
-            fn(VarArgs<T>(sc, args, name));
-            return s7_unspecified(sc);
+        return FunctionTraits<F>::call_with_args([&]<typename...Args>() {
+            using R = typename FunctionTraits<F>::ReturnType;
+            if constexpr(function_has_varargs<F>()) {
+                using LastArg = typename FunctionTraits<F>::Argument<FunctionTraits<F>::arity - 1>::Type;
+                return call_varargs_fn<R, typename LastArg::Type>(sc, args, fn, name);
+            } else {
+                return call_fn<R, Args...>(sc, args, fn, name);
+            }
+        });
+    }
+
+    /*
+     * once the pool of an s7_function signature is full, a function keeps its
+     * callable in a c-object of its own instead, freed with it by the gc, and
+     * is defined as a closure calling that object (see stored_value()).
+     * that's a slower call with no fast paths, but there's no limit on how
+     * many there are.
+     */
+    struct StoredFunction {
+        void *data;
+        s7_pointer (*call)(void *data, std::string_view name, s7_scheme *sc, s7_pointer args);
+        void (*destroy)(void *data);
+        std::string_view name;
+    };
+
+    inline s7_pointer call_stored_function(s7_scheme *sc, s7_pointer args)
+    {
+        auto f = static_cast<StoredFunction *>(s7_c_object_value(s7_car(args)));
+        CaughtException e;
+        try {
+            return f->call(f->data, f->name, sc, s7_cdr(args));
+        } catch (...) {
+            e = caught_exception(sc, f->name);
+        }
+        return raise_exception<s7_pointer>(sc, e);
+    }
+
+    inline s7_int stored_function_tag(s7_scheme *sc)
+    {
+        {
+            std::lock_guard<std::mutex> lock(BindingOwners::mutex);
+            auto it = BindingOwners::stored_tags.find(reinterpret_cast<uintptr_t>(sc));
+            if (it != BindingOwners::stored_tags.end()) {
+                return it->second;
+            }
+        }
+        // not under the lock, since s7 may collect garbage and free objects
+        // that look up names of bindings
+        auto tag = s7_make_c_type(sc, "bound-function");
+        s7_c_type_set_ref(sc, tag, call_stored_function);
+        s7_c_type_set_gc_free(sc, tag, [](s7_scheme *, s7_pointer obj) -> s7_pointer {
+            auto f = static_cast<StoredFunction *>(s7_c_object_value(obj));
+            f->destroy(f->data);
+            delete f;
+            return nullptr;
+        });
+        std::lock_guard<std::mutex> lock(BindingOwners::mutex);
+        BindingOwners::stored_tags.insert_or_assign(reinterpret_cast<uintptr_t>(sc), tag);
+        return tag;
+    }
+
+    // bind_callable() for s7_functions, which don't fail when the pool is full
+    template <typename L, typename Invoke>
+    BoundFunction bind_function(s7_scheme *sc, std::string_view name, L &&fn, Invoke invoke)
+    {
+        using Sig = s7_pointer(s7_scheme *, s7_pointer);
+        using Type = std::remove_cvref_t<L>;
+        if constexpr(is_stateless_v<Type>) {
+            return { bind_callable<Sig>(sc, name, FWD(fn), invoke), { nullptr, name } };
         } else {
-            return detail::from(sc, fn(VarArgs<T>(sc, args, name)));
+            Type stored(std::move(fn));
+            void *data;
+            if (auto f = BindingPool<Sig, S7_MAX_BINDINGS>::template bind<Type, Invoke>(sc, name, stored, &data); f) {
+                return { f, { data, name } };
+            }
+            auto obj = s7_make_c_object(sc, stored_function_tag(sc), new StoredFunction {
+                .data    = new Type(std::move(stored)),
+                .call    = [](void *data, std::string_view name, s7_scheme *sc, s7_pointer args) -> s7_pointer {
+                    return Invoke{}(*static_cast<Type *>(data), Caller(name), sc, args);
+                },
+                .destroy = [](void *data) { delete static_cast<Type *>(data); },
+                .name    = name,
+            });
+            return { nullptr, { nullptr, name }, obj, s7_gc_protect(sc, obj) };
         }
     }
 
     template <typename F>
-    s7_function make_s7_function(s7_scheme *sc, std::string_view name, F &&fn)
-    {
-        auto lambda = detail::as_lambda(fn);
-        using L = std::remove_cvref_t<decltype(lambda)>;
-        set_lambda<L>(sc, std::move(lambda), name);
-        return [](s7_scheme *sc, s7_pointer args) -> s7_pointer {
-            return FunctionTraits<F>::call_with_args([&]<typename...Args>() {
-                auto &fn = LambdaTable<L>::lambda;
-                auto name = get_lambda_name<L>(sc);
-                using R = typename FunctionTraits<F>::ReturnType;
-                if constexpr(function_has_varargs<F>()) {
-                    using LastArg = typename FunctionTraits<F>::Argument<FunctionTraits<F>::arity - 1>::Type;
-                    return call_varargs_fn<R, typename LastArg::Type>(sc, args, fn, name);
-                } else {
-                    return call_fn<R, Args...>(sc, args, fn, name);
-                }
+    BoundFunction make_s7_function(s7_scheme *sc, std::string_view name, F &&fn)
+    {
+        return bind_function(sc, name, detail::as_lambda(fn),
+            [](auto &fn, Caller name, s7_scheme *sc, s7_pointer args) -> s7_pointer {
+                return call_bound_fn<F>(sc, args, fn, name);
             });
-        };
     }
 
-    template <typename R, typename... Args>
-    s7_pointer _match_fn(s7_scheme *sc, s7_pointer args, s7_int length, auto &&fn)
+    // (let ((+documentation+ doc) (+signature+ 'sig)) (kind params body)),
+    // the closure standing for a StoredFunction
+    inline s7_pointer stored_closure(s7_scheme *sc, const BoundFunction &f, const char *kind, s7_pointer params, s7_pointer body,
+                                     std::string_view doc, s7_pointer sig)
     {
-        constexpr auto NumArgs = FunctionTraits<decltype(fn)>::arity;
-        if (length != NumArgs) {
-            return nullptr;
+        auto bindings = s7_list(sc, 1, s7_list(sc, 2, symbol<"+documentation+">(sc), s7_make_string_with_length(sc, doc.data(), doc.size())));
+        if (sig) {
+            bindings = s7_cons(sc, s7_list(sc, 2, symbol<"+signature+">(sc), s7_list(sc, 2, symbol<"quote">(sc), sig)), bindings);
         }
+        auto lambda = s7_list(sc, 3, s7_make_symbol(sc, kind), params, body);
+        Entry entry(sc);
+        auto value = s7_eval(sc, s7_list(sc, 3, symbol<"let">(sc), bindings, lambda), s7_rootlet(sc));
+        s7_gc_unprotect_at(sc, f.stored_loc);
+        return value;
+    }
 
-        auto arglist = s7::List(args);
-        std::array<s7_pointer, NumArgs> arr;
-        for (std::size_t i = 0; i < NumArgs; i++) {
-            arr[i] = arglist.advance();
+    // the closure of the given kind (lambda or macro) to define for a stored
+    // function taking min_args to max_args arguments (-1: any number)
+    inline s7_pointer stored_value(s7_scheme *sc, const BoundFunction &f, s7_int min_args, s7_int max_args,
+                                   std::string_view doc, s7_pointer sig, const char *kind = "lambda")
+    {
+        // a function taking a range of arguments checks them itself (an
+        // overload finds no match)
+        if (min_args != max_args) {
+            auto args = symbol<"args">(sc);
+            return stored_closure(sc, f, kind, args, s7_list(sc, 3, symbol<"apply">(sc), f.stored, args), doc, sig);
+        }
+        auto params = s7_nil(sc);
+        for (auto i = max_args; i > 0; i--) {
+            params = s7_cons(sc, s7_make_symbol(sc, std::format("arg{}", i).c_str()), params);
+        }
+        return stored_closure(sc, f, kind, params, s7_cons(sc, f.stored, params), doc, sig);
+    }
+
+    // the same for a function with keyword arguments, whose closure passes
+    // the values of arglist's parameters in order
+    inline s7_pointer stored_star_value(s7_scheme *sc, const BoundFunction &f, std::string_view arglist,
+                                        std::string_view doc, s7_pointer sig)
+    {
+        auto params = read_datum(sc, std::format("({})", arglist));
+        auto values = s7_nil(sc);
+        for (auto p = params; s7_is_pair(p); p = s7_cdr(p)) {
+            auto param = s7_is_pair(s7_car(p)) ? s7_caar(p) : s7_car(p);
+            if (!s7_is_keyword(param)) {
+                values = s7_cons(sc, param, values);
+            }
         }
+        return stored_closure(sc, f, "lambda*", params, s7_cons(sc, f.stored, s7_reverse(sc, values)), doc, sig);
+    }
 
-        auto bools = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-            return std::array<bool, NumArgs> { detail::is<Args>(sc, arr[Is])...  };
-        }(std::make_index_sequence<NumArgs>());
-        auto matches = std::find(bools.begin(), bools.end(), false) == bools.end();
-        if (!matches) {
+    // the value to define for a bound function: make(fn) if it got a c
+    // function, otherwise its stored_value()
+    s7_pointer function_value(s7_scheme *sc, const BoundFunction &f, s7_int min_args, s7_int max_args,
+                              std::string_view doc, s7_pointer sig, auto &&make)
+    {
+        return f.fn ? make(f.fn) : stored_value(sc, f, min_args, max_args, doc, sig);
+    }
+
+    s7_pointer star_function_value(s7_scheme *sc, const BoundFunction &f, std::string_view arglist,
+                                   std::string_view doc, s7_pointer sig, auto &&make)
+    {
+        return f.fn ? make(f.fn) : stored_star_value(sc, f, arglist, doc, sig);
+    }
+
+    /*
+     * s7's optimizer can call a c function directly, with unboxed arguments and
+     * no arglist, if the function was given one of the s7_*_t functions in s7.h.
+     * the shape is picked at compile time from the callable's signature. the codes
+     * are the same as s7's: d = double, i = integer, b = boolean, p = s7_pointer,
+     * v = the value of a c-object. 'P' is used for an argument of any type that's
+     * passed as an s7_pointer and converted with to() (only possible for shapes
+     * that also receive the s7_scheme *, which are the ones with a 7 or a p_ prefix).
+     */
+    template <typename T>
+    constexpr char opt_code()
+    {
+        using Type = std::remove_cvref_t<T>;
+             if constexpr(std::is_same_v<Type, double> || std::is_same_v<Type, float>)  { return 'd'; }
+        else if constexpr(std::is_same_v<Type, s7_int> || std::is_same_v<Type, int>
+                       || std::is_same_v<Type, short>  || std::is_same_v<Type, long>)   { return 'i'; }
+        else if constexpr(std::is_same_v<Type, bool>)                                  { return 'b'; }
+        else if constexpr(std::is_same_v<Type, s7_pointer>)                            { return 'p'; }
+        else if constexpr(std::is_class_v<Type>
+                       && !std::is_same_v<Type, List>       && !std::is_same_v<Type, Function>
+                       && !is_callable_v<Type>
+                       && !std::is_same_v<Type, Let>        && !std::is_same_v<Type, Values>
+                       && !std::is_same_v<Type, InputPort>  && !std::is_same_v<Type, OutputPort>
+                       && !std::is_same_v<Type, s7_complex> && !std::is_same_v<Type, std::string>
+                       && !std::is_same_v<Type, std::string_view>
+                       && !std::is_same_v<Type, FloatBuffer> && !std::is_same_v<Type, BorrowedVector>
+                       && !is_optional_v<Type>              && !is_tuple_v<Type>
+                       && !is_mdspan_v<Type>
+                       && !requires { typename Type::element_type; typename Type::iterator; }
+                       && !requires { typename Type::value_type; typename Type::iterator; }) { return 'v'; }
+        else                                                                           { return '?'; }
+    }
+
+    template <typename L, typename R, typename... Args>
+    struct FastPaths {
+        static constexpr std::size_t NumArgs = sizeof...(Args);
+        static constexpr std::array<char, NumArgs> codes = { opt_code<Args>()... };
+        static constexpr char ret = opt_code<R>();
+
+        template <std::size_t I> using Arg = std::tuple_element_t<I, std::tuple<Args...>>;
+
+        static constexpr bool is_shape(std::string_view shape)
+        {
+            if (shape.size() != NumArgs) {
+                return false;
+            }
+            for (std::size_t i = 0; i < NumArgs; i++) {
+                if (shape[i] != 'P' && shape[i] != codes[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // target is nullptr for stateless callables
+        static std::string_view name(s7_scheme *sc, const FastPathTarget *t)
+        {
+            if constexpr(is_stateless_v<L>) {
+                return get_lambda_name<L>(sc);
+            } else {
+                return t->name;
+            }
+        }
+
+        // with no interpreter running (s7 was entered other than through
+        // Scheme) an exception is left to propagate
+        static R call(const FastPathTarget *t, auto &&...args)
+        {
+            CaughtException e;
+            try {
+                return sync_after(Running::sc, [&]() -> decltype(auto) {
+                    if constexpr(is_stateless_v<L>) {
+                        return L{}(FWD(args)...);
+                    } else {
+                        return (*static_cast<L *>(t->fn))(FWD(args)...);
+                    }
+                });
+            } catch (...) {
+                auto sc = Running::sc;
+                if (!sc) {
+                    throw;
+                }
+                e = caught_exception(sc, name(sc, t));
+            }
+            return raise_exception<R>(Running::sc, e);
+        }
+
+        // for d, i, p and v arguments
+        template <std::size_t I>
+        static decltype(auto) unbox(auto x)
+        {
+            using T = std::remove_cvref_t<Arg<I>>;
+            if constexpr(codes[I] == 'v') {
+                return *reinterpret_cast<T *>(x);
+            } else {
+                return static_cast<T>(x);
+            }
+        }
+
+        // for P arguments
+        template <std::size_t I>
+        static decltype(auto) convert(s7_scheme *sc, s7_pointer p) { return detail::to<arg_type<Arg<I>>>(sc, p); }
+
+        static s7_pointer box(s7_scheme *sc, auto &&f)
+        {
+            if constexpr(std::is_same_v<R, void>) {
+                f();
+                return s7_unspecified(sc);
+            } else {
+                return detail::from(sc, f());
+            }
+        }
+
+        // mirrors the type checking in call_fn() for the P arguments at Is...;
+        // nullptr means all of them are fine
+        template <std::size_t... Is>
+        static s7_pointer check(s7_scheme *sc, const FastPathTarget *t, auto... ps)
+        {
+#if S7_DEBUGGING
+            s7_pointer err = nullptr;
+            auto check_one = [&]<std::size_t I>(s7_pointer p) {
+                if (err == nullptr && !detail::is<Arg<I>>(sc, p)) {
+                    auto type = std::format("a {}", detail::type_to_string<Arg<I>>(sc));
+                    err = s7_wrong_type_arg_error(sc, name(sc, t).data(), I+1, p, type.c_str());
+                }
+            };
+            (check_one.template operator()<Is>(ps), ...);
+            return err;
+#else
+            (void) sc;
+            (void) t;
+            ((void) ps, ...);
             return nullptr;
+#endif
         }
 
-        if constexpr(std::is_same_v<R, void>) {
-            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-                fn(detail::to<Args>(sc, arr[Is])...);
-            }(std::make_index_sequence<NumArgs>());
-            return s7_unspecified(sc);
+        // stateless callables get a function of their own; the others go
+        // through a FastPathPool slot leading to the stored callable
+        template <typename FR, typename... Ps, typename Body>
+        static void set(s7_scheme *sc, s7_pointer f, void (*setter)(s7_scheme *, s7_pointer, FR (*)(Ps...)), const FastPathTarget &target, Body)
+        {
+            if constexpr(is_stateless_v<L>) {
+                setter(sc, f, [](Ps... ps) -> FR { return Body{}(nullptr, ps...); });
+            } else if (auto fp = FastPathPool<FR(Ps...)>::bind(sc, target, [](const FastPathTarget *t, Ps... ps) -> FR { return Body{}(t, ps...); }); fp) {
+                setter(sc, f, fp);
+            }
+        }
+
+        static void install(s7_scheme *sc, s7_pointer f, const FastPathTarget &target)
+        {
+                 if constexpr(ret == 'd' && is_shape(""))     { set(sc, f, s7_set_d_function,     target, [](const FastPathTarget *t) -> s7_double { return static_cast<s7_double>(call(t)); }); }
+            else if constexpr(ret == 'd' && is_shape("d"))    { set(sc, f, s7_set_d_d_function,   target, [](const FastPathTarget *t, s7_double x) -> s7_double { return static_cast<s7_double>(call(t, unbox<0>(x))); }); }
+            else if constexpr(ret == 'd' && is_shape("dd"))   { set(sc, f, s7_set_d_dd_function,  target, [](const FastPathTarget *t, s7_double x1, s7_double x2) -> s7_double { return static_cast<s7_double>(call(t, unbox<0>(x1), unbox<1>(x2))); }); }
+            else if constexpr(ret == 'd' && is_shape("ddd"))  { set(sc, f, s7_set_d_ddd_function, target, [](const FastPathTarget *t, s7_double x1, s7_double x2, s7_double x3) -> s7_double { return static_cast<s7_double>(call(t, unbox<0>(x1), unbox<1>(x2), unbox<2>(x3))); }); }
+            else if constexpr(ret == 'd' && is_shape("dddd")) {
+                set(sc, f, s7_set_d_dddd_function, target, [](const FastPathTarget *t, s7_double x1, s7_double x2, s7_double x3, s7_double x4) -> s7_double {
+                    return static_cast<s7_double>(call(t, unbox<0>(x1), unbox<1>(x2), unbox<2>(x3), unbox<3>(x4)));
+                });
+            }
+            else if constexpr(ret == 'd' && is_shape("v"))    { set(sc, f, s7_set_d_v_function,   target, [](const FastPathTarget *t, void *v) -> s7_double { return static_cast<s7_double>(call(t, unbox<0>(v))); }); }
+            else if constexpr(ret == 'd' && is_shape("vd"))   { set(sc, f, s7_set_d_vd_function,  target, [](const FastPathTarget *t, void *v, s7_double d) -> s7_double { return static_cast<s7_double>(call(t, unbox<0>(v), unbox<1>(d))); }); }
+            else if constexpr(ret == 'd' && is_shape("vdd"))  { set(sc, f, s7_set_d_vdd_function, target, [](const FastPathTarget *t, void *v, s7_double x1, s7_double x2) -> s7_double { return static_cast<s7_double>(call(t, unbox<0>(v), unbox<1>(x1), unbox<2>(x2))); }); }
+            else if constexpr(ret == 'd' && is_shape("vid"))  { set(sc, f, s7_set_d_vid_function, target, [](const FastPathTarget *t, void *v, s7_int i, s7_double d) -> s7_double { return static_cast<s7_double>(call(t, unbox<0>(v), unbox<1>(i), unbox<2>(d))); }); }
+            else if constexpr(ret == 'd' && is_shape("p"))    { set(sc, f, s7_set_d_p_function,   target, [](const FastPathTarget *t, s7_pointer p) -> s7_double { return static_cast<s7_double>(call(t, p)); }); }
+            else if constexpr(ret == 'd' && is_shape("pd"))   { set(sc, f, s7_set_d_pd_function,  target, [](const FastPathTarget *t, s7_pointer p, s7_double d) -> s7_double { return static_cast<s7_double>(call(t, p, unbox<1>(d))); }); }
+            else if constexpr(ret == 'd' && is_shape("id"))   { set(sc, f, s7_set_d_id_function,  target, [](const FastPathTarget *t, s7_int i, s7_double d) -> s7_double { return static_cast<s7_double>(call(t, unbox<0>(i), unbox<1>(d))); }); }
+            else if constexpr(ret == 'd' && is_shape("ip"))   { set(sc, f, s7_set_d_ip_function,  target, [](const FastPathTarget *t, s7_int i, s7_pointer p) -> s7_double { return static_cast<s7_double>(call(t, unbox<0>(i), p)); }); }
+            else if constexpr(ret == 'd' && is_shape("Pi"))   {
+                set(sc, f, s7_set_d_7pi_function, target, [](const FastPathTarget *t, s7_scheme *sc, s7_pointer p, s7_int i) -> s7_double {
+                    if (auto err = check<0>(sc, t, p); err) {
+                        return s7_real(err);
+                    }
+                    return static_cast<s7_double>(call(t, convert<0>(sc, p), unbox<1>(i)));
+                });
+            }
+            else if constexpr(ret == 'd' && is_shape("Pid")) {
+                set(sc, f, s7_set_d_7pid_function, target, [](const FastPathTarget *t, s7_scheme *sc, s7_pointer p, s7_int i, s7_double d) -> s7_double {
+                    if (auto err = check<0>(sc, t, p); err) {
+                        return s7_real(err);
+                    }
+                    return static_cast<s7_double>(call(t, convert<0>(sc, p), unbox<1>(i), unbox<2>(d)));
+                });
+            }
+            else if constexpr(ret == 'i' && is_shape("i"))    { set(sc, f, s7_set_i_i_function,   target, [](const FastPathTarget *t, s7_int x) -> s7_int { return static_cast<s7_int>(call(t, unbox<0>(x))); }); }
+            else if constexpr(ret == 'i' && is_shape("ii"))   { set(sc, f, s7_set_i_ii_function,  target, [](const FastPathTarget *t, s7_int x1, s7_int x2) -> s7_int { return static_cast<s7_int>(call(t, unbox<0>(x1), unbox<1>(x2))); }); }
+            else if constexpr(ret == 'i' && is_shape("d"))    { set(sc, f, s7_set_i_7d_function,  target, [](const FastPathTarget *t, s7_scheme *, s7_double x) -> s7_int { return static_cast<s7_int>(call(t, unbox<0>(x))); }); }
+            else if constexpr(ret == 'i' && is_shape("P"))    {
+                set(sc, f, s7_set_i_7p_function, target, [](const FastPathTarget *t, s7_scheme *sc, s7_pointer p) -> s7_int {
+                    if (auto err = check<0>(sc, t, p); err) {
+                        return s7_integer(err);
+                    }
+                    return static_cast<s7_int>(call(t, convert<0>(sc, p)));
+                });
+            }
+            else if constexpr(ret == 'b' && is_shape("p"))    { set(sc, f, s7_set_b_p_function,   target, [](const FastPathTarget *t, s7_pointer p) -> bool { return call(t, p); }); }
+            // boxed results, still without an arglist
+            else if constexpr(is_shape("d"))                  { set(sc, f, s7_set_p_d_function,   target, [](const FastPathTarget *t, s7_scheme *sc, s7_double x) -> s7_pointer { return box(sc, [&] { return call(t, unbox<0>(x)); }); }); }
+            else if constexpr(is_shape("P")) {
+                set(sc, f, s7_set_p_p_function, target, [](const FastPathTarget *t, s7_scheme *sc, s7_pointer p) -> s7_pointer {
+                    if (auto err = check<0>(sc, t, p); err) {
+                        return err;
+                    }
+                    return box(sc, [&] { return call(t, convert<0>(sc, p)); });
+                });
+            }
+            else if constexpr(is_shape("PP")) {
+                set(sc, f, s7_set_p_pp_function, target, [](const FastPathTarget *t, s7_scheme *sc, s7_pointer p1, s7_pointer p2) -> s7_pointer {
+                    if (auto err = check<0, 1>(sc, t, p1, p2); err) {
+                        return err;
+                    }
+                    return box(sc, [&] { return call(t, convert<0>(sc, p1), convert<1>(sc, p2)); });
+                });
+            }
+            else if constexpr(is_shape("PPP")) {
+                set(sc, f, s7_set_p_ppp_function, target, [](const FastPathTarget *t, s7_scheme *sc, s7_pointer p1, s7_pointer p2, s7_pointer p3) -> s7_pointer {
+                    if (auto err = check<0, 1, 2>(sc, t, p1, p2, p3); err) {
+                        return err;
+                    }
+                    return box(sc, [&] { return call(t, convert<0>(sc, p1), convert<1>(sc, p2), convert<2>(sc, p3)); });
+                });
+            }
+        }
+    };
+
+    // bound is what make_s7_function returned for the same callable.
+    // functions that may call back into the evaluator must stay out of the
+    // optimizer, and a StoredFunction's closure can't have fast paths.
+    template <typename F>
+    void set_fast_paths(s7_scheme *sc, s7_pointer f, FunctionOpts opts, const BoundFunction &bound)
+    {
+        using L = std::remove_cvref_t<decltype(detail::as_lambda(std::declval<F &>()))>;
+        if constexpr(!function_has_varargs<F>()) {
+            if (opts.unsafe_body || opts.unsafe_arglist || !bound.fn) {
+                return;
+            }
+            using R = typename FunctionTraits<F>::ReturnType;
+            FunctionTraits<F>::call_with_args([&]<typename... Args>() {
+                FastPaths<L, R, Args...>::install(sc, f, bound.target);
+            });
+        }
+    }
+
+    // what an overload can tell about an argument without running any of the
+    // candidates' predicates. c-objects are the exception: which usertype (or
+    // whether it's applicable) is only known at runtime.
+    enum class ArgClass : uint8_t {
+        // #f on its own, as std::optional takes it but not #t
+        Integer, Real, Complex, False, True, String, Character, Pair,
+        Vector, IntVector, FloatVector, ByteVector, CPointer,
+        Procedure, Let, InputPort, OutputPort, CObject, Other,
+    };
+
+    inline ArgClass classify(s7_scheme *sc, s7_pointer p)
+    {
+        if (s7_is_number(p)) {
+            return s7_is_integer(p) ? ArgClass::Integer
+                 : s7_is_real(p)    ? ArgClass::Real
+                 :                    ArgClass::Complex;
+        }
+        // before procedures, as c-objects can be applicable
+             if (s7_is_c_object(p))        { return ArgClass::CObject;     }
+        else if (p == s7_f(sc))            { return ArgClass::False;       }
+        else if (p == s7_t(sc))            { return ArgClass::True;        }
+        else if (s7_is_string(p))          { return ArgClass::String;      }
+        else if (s7_is_character(p))       { return ArgClass::Character;   }
+        else if (s7_is_pair(p))            { return ArgClass::Pair;        }
+        else if (s7_is_int_vector(p))      { return ArgClass::IntVector;   }
+        else if (s7_is_float_vector(p))    { return ArgClass::FloatVector; }
+        else if (s7_is_byte_vector(p))     { return ArgClass::ByteVector;  }
+        else if (s7_is_vector(p))          { return ArgClass::Vector;      }
+        else if (s7_is_c_pointer(p))       { return ArgClass::CPointer;    }
+        else if (s7_is_procedure(p))       { return ArgClass::Procedure;   }
+        else if (s7_is_let(p))             { return ArgClass::Let;         }
+        else if (s7_is_input_port(sc, p))  { return ArgClass::InputPort;   }
+        else if (s7_is_output_port(sc, p)) { return ArgClass::OutputPort;  }
+        return ArgClass::Other;
+    }
+
+    template <typename... Cs>
+    constexpr uint32_t class_bits(Cs... cs) { return ((1u << static_cast<unsigned>(cs)) | ... | 0u); }
+
+    // the classes for which is<T>() is true. must be kept in sync with is<T>().
+    template <typename T>
+    constexpr uint32_t accepted_classes()
+    {
+        using C = ArgClass;
+             if constexpr(std::is_same_v<T, s7_pointer>)            { return ~0u;                                                                }
+        else if constexpr(std::is_same_v<T, bool>)                  { return class_bits(C::False, C::True);                                      }
+        else if constexpr(std::is_same_v<T, s7_int>)                { return class_bits(C::Integer);                                             }
+        else if constexpr(std::is_same_v<T, double>)                { return class_bits(C::Integer, C::Real);                                    }
+        else if constexpr(std::is_same_v<T, s7_complex>)            { return class_bits(C::Integer, C::Real, C::Complex);                        }
+        else if constexpr(std::is_same_v<T, const char *>
+                       || std::is_same_v<T, std::string_view>)      { return class_bits(C::String);                                              }
+        else if constexpr(std::is_same_v<T, unsigned char>)         { return class_bits(C::Character);                                           }
+        else if constexpr(std::is_same_v<T, std::span<s7_pointer>>) { return class_bits(C::Vector, C::IntVector, C::FloatVector, C::ByteVector); }
+        else if constexpr(std::is_same_v<T, std::span<s7_int>>)     { return class_bits(C::IntVector);                                           }
+        else if constexpr(std::is_same_v<T, std::span<double>>)     { return class_bits(C::FloatVector);                                         }
+        else if constexpr(std::is_same_v<T, std::span<uint8_t>>)    { return class_bits(C::ByteVector);                                          }
+        else if constexpr(is_int_vector_copy_v<T>)                  { return class_bits(C::IntVector);                                           }
+        else if constexpr(is_float_vector_copy_v<T>)                { return class_bits(C::FloatVector);                                         }
+        else if constexpr(is_byte_vector_copy_v<T>)                 { return class_bits(C::ByteVector);                                          }
+        else if constexpr(std::is_same_v<std::remove_cvref_t<T>, std::string>) { return class_bits(C::String);                                   }
+        else if constexpr(is_optional_v<T>)                         { return accepted_classes<typename std::remove_cvref_t<T>::value_type>() | class_bits(C::False); }
+        // hash-tables and '() classify as Other
+        else if constexpr(is_tuple_v<T>)                            { return class_bits(C::Pair, C::Other);                                      }
+        else if constexpr(is_map_v<T>)                              { return class_bits(C::Other);                                               }
+        else if constexpr(is_set_v<T> || is_sequence_v<T>)          { return class_bits(C::Vector, C::IntVector, C::FloatVector, C::ByteVector, C::Pair, C::Other); }
+        else if constexpr(is_mdspan_v<T>) {
+            using E = std::remove_const_t<typename std::remove_cvref_t<T>::element_type>;
+            return std::is_same_v<E, double>  ? class_bits(C::FloatVector) : std::is_same_v<E, s7_int> ? class_bits(C::IntVector)
+                 : std::is_same_v<E, uint8_t> ? class_bits(C::ByteVector)  : class_bits(C::Vector);
+        }
+        else if constexpr(std::is_pointer_v<T>)                     { return class_bits(C::CPointer);                                            }
+        else if constexpr(std::is_same_v<T, List>)                  { return class_bits(C::Pair);                                                }
+        else if constexpr(std::is_same_v<T, Function>
+                       || is_callable_v<T>)                         { return class_bits(C::Procedure);                                           }
+        else if constexpr(std::is_same_v<T, Let>)                   { return class_bits(C::Let);                                                 }
+        else if constexpr(std::is_same_v<T, InputPort>)             { return class_bits(C::InputPort);                                           }
+        else if constexpr(std::is_same_v<T, OutputPort>)            { return class_bits(C::OutputPort);                                          }
+        else if constexpr(std::is_same_v<T, int> || std::is_same_v<T, short> || std::is_same_v<T, long>) { return class_bits(C::Integer); }
+        else if constexpr(std::is_same_v<T, float>)                 { return class_bits(C::Integer, C::Real);                                    }
+        return 0;
+    }
+
+    // whether is<T>() must be run for c-objects
+    template <typename T>
+    constexpr bool checks_c_objects()
+    {
+        if constexpr(is_optional_v<T>) {
+            return checks_c_objects<typename std::remove_cvref_t<T>::value_type>();
         } else {
-            return detail::from<R>(sc, [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-                return fn(detail::to<Args>(sc, arr[Is])...);
-            }(std::make_index_sequence<NumArgs>()));
+            return std::is_same_v<T, Function> || is_callable_v<T> || accepted_classes<T>() == 0 || checks_elements<T>();
         }
     }
 
-    template <typename F>
-    s7_pointer match_fn(s7_scheme *sc, s7_pointer args, s7_int length, std::string_view name, F &&fn)
-    {
-        return FunctionTraits<F>::call_with_args([&]<typename...Args>() {
-            using R = typename FunctionTraits<F>::ReturnType;
-            if constexpr(function_has_varargs<F>()) {
-                using LastArg = typename FunctionTraits<F>::Argument<FunctionTraits<F>::arity - 1>::Type;
-                return call_varargs_fn<R, typename LastArg::Type>(sc, args, fn, name);
-            } else {
-                return _match_fn<R, Args...>(sc, args, length, fn);
+    // remembers which candidate matched the last call, keyed on the arity
+    // and on the class (or usertype tag) of each argument
+    struct OverloadCache {
+        uint64_t key = 0;
+        std::size_t index = 0;
+    };
+
+    // overload resolution done with table lookups: candidates are bucketed by
+    // arity, then each argument is classified once and narrows the remaining
+    // candidates with a precomputed mask. the lowest bit left is the first
+    // candidate, in declaration order, that would have matched.
+    template <typename... Fns>
+    struct OverloadTable {
+        static constexpr std::size_t NumFns = sizeof...(Fns);
+        static constexpr std::size_t MaxArity = vmax(FunctionTraits<Fns>::arity...);
+        static constexpr std::size_t NumClasses = static_cast<std::size_t>(ArgClass::Other) + 1;
+        static constexpr std::array<std::size_t, NumFns> arities = { FunctionTraits<Fns>::arity... };
+        static constexpr std::array<bool, NumFns> varargs = { function_has_varargs<Fns>()... };
+        static constexpr bool has_varargs = (function_has_varargs<Fns>() || ...);
+        static constexpr bool has_containers = (FunctionTraits<Fns>::call_with_args([]<typename... Args>() {
+            return (checks_elements<Args>() || ... || false);
+        }) || ...);
+        // eight bits for the arity and for each argument; containers match on
+        // their elements, which the key doesn't see
+        static constexpr bool cacheable = !has_varargs && !has_containers && MaxArity < 8;
+
+        static_assert(NumFns <= 64, "too many functions in overload");
+
+        // varargs functions take anything and check by themselves
+        template <typename F, std::size_t J>
+        static constexpr uint32_t accepts_at()
+        {
+            if constexpr(function_has_varargs<F>() || J >= FunctionTraits<F>::arity) {
+                return ~0u;
+            } else {
+                return accepted_classes<typename FunctionTraits<F>::Argument<J>::Type>();
+            }
+        }
+
+        template <typename F, std::size_t J>
+        static constexpr bool checks_at()
+        {
+            if constexpr(function_has_varargs<F>() || J >= FunctionTraits<F>::arity) {
+                return false;
+            } else {
+                return checks_c_objects<typename FunctionTraits<F>::Argument<J>::Type>();
+            }
+        }
+
+        template <typename F, std::size_t J>
+        static constexpr bool checks_elements_at()
+        {
+            if constexpr(function_has_varargs<F>() || J >= FunctionTraits<F>::arity) {
+                return false;
+            } else {
+                return checks_elements<typename FunctionTraits<F>::Argument<J>::Type>();
+            }
+        }
+
+        // candidates taking n arguments, the last entry is for more than MaxArity
+        static constexpr auto by_arity = [] {
+            std::array<uint64_t, MaxArity + 2> t = {};
+            for (std::size_t n = 0; n < t.size(); n++) {
+                for (std::size_t i = 0; i < NumFns; i++) {
+                    if (varargs[i] || arities[i] == n) {
+                        t[n] |= uint64_t(1) << i;
+                    }
+                }
+            }
+            return t;
+        }();
+
+        // candidates accepting class c at position J
+        template <std::size_t J>
+        static constexpr auto by_class = [] {
+            constexpr std::array<uint32_t, NumFns> accepts = { accepts_at<Fns, J>()... };
+            std::array<uint64_t, NumClasses> t = {};
+            for (std::size_t c = 0; c < NumClasses; c++) {
+                for (std::size_t i = 0; i < NumFns; i++) {
+                    if (accepts[i] & (1u << c)) {
+                        t[c] |= uint64_t(1) << i;
+                    }
+                }
+            }
+            return t;
+        }();
+
+        // c-objects at position J: only candidates still in mask that need it run is<T>()
+        template <std::size_t J>
+        static uint64_t check_c_object(s7_scheme *sc, s7_pointer p, uint64_t mask)
+        {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return ([&] {
+                    using F = std::tuple_element_t<Is, std::tuple<Fns...>>;
+                    if constexpr(checks_at<F, J>()) {
+                        using T = typename FunctionTraits<F>::Argument<J>::Type;
+                        return (mask & (uint64_t(1) << Is)) && detail::is<T>(sc, p) ? uint64_t(1) << Is : 0;
+                    } else {
+                        return uint64_t(0);
+                    }
+                }() | ... | uint64_t(0));
+            }(std::index_sequence_for<Fns...>());
+        }
+
+        // candidates whose argument J is a container
+        template <std::size_t J>
+        static constexpr uint64_t by_elements = [] {
+            constexpr std::array<bool, NumFns> checks = { checks_elements_at<Fns, J>()... };
+            uint64_t t = 0;
+            for (std::size_t i = 0; i < NumFns; i++) {
+                t |= checks[i] ? uint64_t(1) << i : 0;
+            }
+            return t;
+        }();
+
+        // containers at position J: candidates in mask run is<T>() on the elements
+        template <std::size_t J>
+        static uint64_t check_elements(s7_scheme *sc, s7_pointer p, uint64_t mask)
+        {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return ([&] {
+                    using F = std::tuple_element_t<Is, std::tuple<Fns...>>;
+                    if constexpr(checks_elements_at<F, J>()) {
+                        using T = typename FunctionTraits<F>::Argument<J>::Type;
+                        return (mask & (uint64_t(1) << Is)) && detail::is<T>(sc, p) ? uint64_t(1) << Is : 0;
+                    } else {
+                        return uint64_t(0);
+                    }
+                }() | ... | uint64_t(0));
+            }(std::index_sequence_for<Fns...>());
+        }
+
+        template <std::size_t I, typename Tuple>
+        static s7_pointer call(Tuple &fns, Caller name, s7_scheme *sc, s7_pointer args, const s7_pointer *arr)
+        {
+            using F = std::tuple_element_t<I, std::tuple<Fns...>>;
+            using R = typename FunctionTraits<F>::ReturnType;
+            auto &fn = std::get<I>(fns);
+            if constexpr(function_has_varargs<F>()) {
+                using LastArg = typename FunctionTraits<F>::Argument<FunctionTraits<F>::arity - 1>::Type;
+                return call_varargs_fn<R, typename LastArg::Type>(sc, args, fn, name);
+            } else {
+                return FunctionTraits<F>::call_with_args([&]<typename... Args>() {
+                    return invoke_fn<R, Args...>(sc, arr, fn);
+                });
+            }
+        }
+
+        // returns NumFns if nothing matches
+        static std::size_t match(s7_scheme *sc, std::size_t n, const s7_pointer *arr, const ArgClass *classes)
+        {
+            auto mask = by_arity[std::min(n, MaxArity + 1)];
+            // table lookups first, so that c-objects (which need a tag lookup
+            // per usertype) are checked only against the candidates left
+            auto narrow = [&]<std::size_t J>(bool c_objects) {
+                if (J >= n || !mask) {
+                    return false;
+                }
+                auto is_c_object = classes[J] == ArgClass::CObject;
+                if (!c_objects && !is_c_object) {
+                    mask &= by_class<J>[std::size_t(classes[J])];
+                } else if (c_objects && is_c_object) {
+                    mask &= by_class<J>[std::size_t(ArgClass::CObject)] | check_c_object<J>(sc, arr[J], mask);
+                } else if (c_objects && (mask & by_elements<J>)) {
+                    mask = (mask & ~by_elements<J>) | check_elements<J>(sc, arr[J], mask & by_elements<J>);
+                }
+                return true;
+            };
+            [&]<std::size_t... Js>(std::index_sequence<Js...>) {
+                static_cast<void>((narrow.template operator()<Js>(false) && ...));
+                static_cast<void>((narrow.template operator()<Js>(true) && ...));
+            }(std::make_index_sequence<MaxArity>());
+            return mask ? static_cast<std::size_t>(std::countr_zero(mask)) : NumFns;
+        }
+
+        static uint64_t cache_key(std::size_t n, const s7_pointer *arr, const ArgClass *classes)
+        {
+            if (n > MaxArity) {
+                return 0;
+            }
+            uint64_t key = n + 1;
+            for (std::size_t j = 0; j < n; j++) {
+                uint64_t code = static_cast<uint64_t>(classes[j]);
+                if (classes[j] == ArgClass::CObject) {
+                    auto tag = s7_c_object_type(arr[j]);
+                    if (tag < 0 || tag >= s7_int(256 - NumClasses)) {
+                        return 0;
+                    }
+                    code = NumClasses + static_cast<uint64_t>(tag);
+                }
+                key |= code << (8 * (j + 1));
+            }
+            return key;
+        }
+
+        // returns nullptr if nothing matches
+        template <typename Tuple>
+        static s7_pointer dispatch(Tuple &fns, OverloadCache *cache, Caller name, s7_scheme *sc, s7_pointer args)
+        {
+            using CallFn = s7_pointer (*)(Tuple &, Caller, s7_scheme *, s7_pointer, const s7_pointer *);
+            static constexpr auto calls = []<std::size_t... Is>(std::index_sequence<Is...>) {
+                return std::array<CallFn, NumFns> { &call<Is, Tuple>... };
+            }(std::index_sequence_for<Fns...>());
+
+            // one more slot than needed so that arr is never empty
+            std::array<s7_pointer, MaxArity + 1> arr;
+            std::array<ArgClass, MaxArity + 1> classes;
+            std::size_t n = 0;
+            for (auto p = args; s7_is_pair(p) && n <= MaxArity; p = s7_cdr(p), n++) {
+                arr[n] = s7_car(p);
+                classes[n] = classify(sc, arr[n]);
+            }
+
+            uint64_t key = 0;
+            if constexpr(cacheable) {
+                if (cache) {
+                    key = cache_key(n, arr.data(), classes.data());
+                    if (key != 0 && key == cache->key) {
+                        return calls[cache->index](fns, name, sc, args, arr.data());
+                    }
+                }
             }
-        });
-    }
 
-    template <typename F>
-    s7_pointer match_fns(s7_scheme *sc, s7_pointer args, s7_int length, std::string_view name, F &&f)
-    {
-        return match_fn(sc, args, length, name, f);
-    }
+            auto i = match(sc, n, arr.data(), classes.data());
+            if (i == NumFns) {
+                return nullptr;
+            }
+            if (cache && key != 0) {
+                *cache = { .key = key, .index = i };
+            }
+            return calls[i](fns, name, sc, args, arr.data());
+        }
+    };
+
+    template <typename Tuple>
+    struct CachedOverload {
+        Tuple fns;
+        OverloadCache cache;
+    };
 
-    template <typename F, typename... Fns>
-    s7_pointer match_fns(s7_scheme *sc, s7_pointer args, s7_int length, std::string_view name, F &&f, Fns &&...fns)
+    template <typename... Fns>
+    s7_pointer overload_no_match(Caller name, s7_scheme *sc, s7_pointer args)
     {
-        auto p = match_fn(sc, args, length, name, f);
-        return p ? p : match_fns(sc, args, length, name, fns...);
+        constexpr auto NumFns = sizeof...(Fns);
+        std::vector<s7_pointer> types;
+        for (auto arg : s7::List(args)) {
+            auto name = std::format("{}?", type_of(sc, arg));
+            types.push_back(s7_make_symbol(sc, name.c_str()));
+        }
+        auto str = std::format("{}: arglist ~a doesn't match any signature\n"
+                               ";valid signatures:", name.get(sc));
+        for (auto i = 0u; i < NumFns; i++) {
+            str += "\n;~a";
+        }
+        auto msg = detail::from(sc, str);
+        return s7_error(sc, s7_make_symbol(sc, "overload-no-match"), s7_list_nl(
+            sc, sizeof...(Fns) + 2,
+            msg, s7_array_to_list(sc, types.size(), types.data()),
+            detail::make_signature<Fns>(sc)...,
+            nullptr
+        ));
     }
 
     template <typename... Fns>
-    s7_function make_overload(s7_scheme *sc, std::string_view name, Fns&&... fns)
+    BoundFunction make_overload(s7_scheme *sc, std::string_view name, FunctionOpts opts, Fns&&... fns)
     {
-        constexpr auto NumFns = sizeof...(Fns);
-        (set_lambda(sc, std::move(fns), name), ...);
-
-        return [](s7_scheme *sc, s7_pointer args) -> s7_pointer {
-            auto length = s7_list_length(sc, args);
-            using FirstFn = std::remove_cvref_t<typename std::tuple_element<0, std::tuple<Fns...>>::type>;
-            auto name = get_lambda_name<FirstFn>(sc);
-            auto res = match_fns(sc, args, length, name, detail::LambdaTable<std::remove_cvref_t<Fns>>::lambda...);
-            if (res) {
-                return res;
-            }
-
-            std::vector<s7_pointer> types;
-            for (auto arg : s7::List(args)) {
-                auto name = std::format("{}?", type_of(sc, arg));
-                types.push_back(s7_make_symbol(sc, name.c_str()));
-            }
-            auto str = std::format("{}: arglist ~a doesn't match any signature\n"
-                                   ";valid signatures:", name);
-            for (auto i = 0u; i < NumFns; i++) {
-                str += "\n;~a";
-            }
-            auto msg = detail::from(sc, str);
-            return s7_error(sc, s7_make_symbol(sc, "overload-no-match"), s7_list_nl(
-                sc, sizeof...(Fns) + 2,
-                msg, s7_array_to_list(sc, types.size(), types.data()),
-                detail::make_signature<Fns>(sc)...,
-                nullptr
-            ));
-        };
+        using Table = OverloadTable<std::remove_cvref_t<Fns>...>;
+        using Tuple = std::tuple<std::remove_cvref_t<Fns>...>;
+
+        auto tuple = Tuple(std::move(fns)...);
+        if constexpr(Table::cacheable) {
+            if (opts.cache_overload) {
+                return bind_function(sc, name, CachedOverload<Tuple> { std::move(tuple), {} },
+                    [](auto &overload, Caller name, s7_scheme *sc, s7_pointer args) -> s7_pointer {
+                        auto res = Table::dispatch(overload.fns, &overload.cache, name, sc, args);
+                        return res ? res : overload_no_match<Fns...>(name, sc, args);
+                    });
+            }
+        }
+        return bind_function(sc, name, std::move(tuple),
+            [](auto &fns, Caller name, s7_scheme *sc, s7_pointer args) -> s7_pointer {
+                auto res = Table::dispatch(fns, nullptr, name, sc, args);
+                return res ? res : overload_no_match<Fns...>(name, sc, args);
+            });
     }
 
     Function make_function(s7_scheme *sc, std::string_view name, std::string_view doc, s7_function fn, FunctionOpts opts)
@@ -828,22 +2927,26 @@ namespace detail {
     }
 
     template <typename F>
-    Function make_function(s7_scheme *sc, std::string_view name, std::string_view doc, F &&func, FunctionOpts)
+    Function make_function(s7_scheme *sc, std::string_view name, std::string_view doc, F &&func, FunctionOpts opts)
     {
         constexpr auto NumArgs = FunctionTraits<F>::arity;
         auto _name = s7_string(s7_make_semipermanent_string(sc, name.data()));
         auto f = detail::make_s7_function(sc, _name, func);
         auto sig = make_signature(sc, func);
-        return Function(s7_make_typed_function(sc, _name, f, NumArgs, 0, false, doc.data(), sig));
+        auto fn = function_value(sc, f, NumArgs, NumArgs, doc, sig, [&](s7_function fn) {
+            return s7_make_typed_function(sc, _name, fn, NumArgs, 0, false, doc.data(), sig);
+        });
+        detail::set_fast_paths<F>(sc, fn, opts, f);
+        return Function(fn);
     }
 
     template <typename... Fns>
     Function make_function(s7_scheme *sc, std::string_view name, std::string_view doc, Overload<Fns...> &&overload, FunctionOpts opts)
     {
+        auto _name = s7_string(s7_make_semipermanent_string(sc, name.data()));
         auto f = std::apply([&]<typename ...F>(F &&...fns) {
-            return detail::make_overload(sc, name, detail::as_lambda(fns)...);
+            return detail::make_overload(sc, _name, opts, detail::as_lambda(fns)...);
         }, overload.fns);
-        auto _name = s7_string(s7_make_semipermanent_string(sc, name.data()));
         auto make = opts.unsafe_arglist || opts.unsafe_body
             ? s7_make_function
             : s7_make_safe_function;
@@ -852,11 +2955,15 @@ namespace detail {
         }, overload.fns);
         if constexpr(has_varargs) {
             constexpr auto MinArgs = detail::min_arity<Fns...>();
-            return Function(make(sc, _name, f, MinArgs, 0, true, doc.data()));
+            return Function(function_value(sc, f, MinArgs, -1, doc, nullptr, [&](s7_function fn) {
+                return make(sc, _name, fn, MinArgs, 0, true, doc.data());
+            }));
         } else {
             constexpr auto MaxArgs = detail::max_arity<Fns...>();
             constexpr auto MinArgs = detail::min_arity<Fns...>();
-            return Function(make(sc, _name, f, MinArgs, MaxArgs - MinArgs, false, doc.data()));
+            return Function(function_value(sc, f, MinArgs, MaxArgs, doc, nullptr, [&](s7_function fn) {
+                return make(sc, _name, fn, MinArgs, MaxArgs - MinArgs, false, doc.data());
+            }));
         }
     }
 
@@ -870,7 +2977,9 @@ namespace detail {
     {
         auto _name = s7_string(s7_make_semipermanent_string(sc, name.data()));
         auto f = detail::make_s7_function(sc, _name, func);
-        return Function(s7_make_function_star(sc, _name, f, arglist_desc.data(), doc.data()));
+        return Function(star_function_value(sc, f, arglist_desc, doc, nullptr, [&](s7_function fn) {
+            return s7_make_function_star(sc, _name, fn, arglist_desc.data(), doc.data());
+        }));
     }
 } // namespace detail
 
@@ -907,17 +3016,27 @@ enum class Op {
     Length, ToString, ToList, Ref, Set,
 };
 
+// Neg is unary -, and shares the - entry with Sub
 enum class MethodOp {
-    Add, Sub, Mul, Div
+    Add, Sub, Mul, Div,
+    Lt, Gt, Leq, Geq, Eq,
+    Abs, Neg,
 };
 
 template <MethodOp op>
 constexpr std::string_view method_op_fn()
 {
-    if constexpr(op == MethodOp::Add) { return "+"; }
-    if constexpr(op == MethodOp::Sub) { return "-"; }
-    if constexpr(op == MethodOp::Mul) { return "*"; }
-    if constexpr(op == MethodOp::Div) { return "/"; }
+    if constexpr(op == MethodOp::Add) { return "+";   }
+    if constexpr(op == MethodOp::Sub) { return "-";   }
+    if constexpr(op == MethodOp::Mul) { return "*";   }
+    if constexpr(op == MethodOp::Div) { return "/";   }
+    if constexpr(op == MethodOp::Lt)  { return "<";   }
+    if constexpr(op == MethodOp::Gt)  { return ">";   }
+    if constexpr(op == MethodOp::Leq) { return "<=";  }
+    if constexpr(op == MethodOp::Geq) { return ">=";  }
+    if constexpr(op == MethodOp::Eq)  { return "=";   }
+    if constexpr(op == MethodOp::Abs) { return "abs"; }
+    if constexpr(op == MethodOp::Neg) { return "-";   }
 }
 
 // implementation taken from https://github.com/ThePhD/sol2/blob/develop/include/sol/resolve.hpp
@@ -925,6 +3044,66 @@ constexpr std::string_view method_op_fn()
 template <typename Sig>             inline constexpr Sig    *resolve(Sig    *f) { return f; }
 template <typename Sig, typename C> inline constexpr Sig C::*resolve(Sig C::*f) { return f; }
 
+/*
+ * a variable whose slot is looked up once (and defined if missing), so that
+ * reading and writing it skip the symbol lookup. for doubles, set_in_place()
+ * writes into a mutable real owned by the handle with s7_slot_set_real_value
+ * and so doesn't allocate, but anything that took the variable's value (e.g.
+ * (define saved x)) sees the write too: only use it for values that scheme
+ * code just computes with. the handle doesn't keep its let alive.
+ */
+template <typename T>
+class BoundVariable {
+    s7_scheme *sc = nullptr;
+    s7_pointer slot = nullptr;
+    s7_pointer real = nullptr;
+    s7_int loc = -1;
+
+public:
+    BoundVariable(s7_scheme *sc, s7_pointer let, s7_pointer sym) : sc(sc)
+    {
+        if (s7_let_ref(sc, let, sym) == s7_undefined(sc)) {
+            s7_define(sc, let, sym, s7_nil(sc));
+        }
+        auto old = s7_set_curlet(sc, let);
+        slot = s7_slot(sc, sym);
+        s7_set_curlet(sc, old);
+        if constexpr(std::is_floating_point_v<T>) {
+            real = s7_make_mutable_real(sc, 0.0);
+            loc = s7_gc_protect(sc, real);
+        }
+    }
+
+    BoundVariable(const BoundVariable &) = delete;
+    BoundVariable & operator=(const BoundVariable &) = delete;
+    BoundVariable(BoundVariable &&other)
+        : sc(other.sc), slot(other.slot), real(other.real), loc(std::exchange(other.loc, -1)) {}
+
+    ~BoundVariable()
+    {
+        if (loc != -1) {
+            s7_gc_unprotect_at(sc, loc);
+        }
+    }
+
+    s7_pointer ptr() const { return slot; }
+
+    T get() const { return detail::to<T>(sc, s7_slot_value(slot)); }
+
+    void set(const T &value) { s7_slot_set_value(sc, slot, detail::from(sc, value)); }
+
+    void set_in_place(T value) requires std::is_floating_point_v<T>
+    {
+        if (s7_slot_value(slot) != real) {
+            s7_slot_set_value(sc, slot, real);
+        }
+        s7_slot_set_real_value(sc, slot, value);
+    }
+
+    operator T() const { return get(); }
+    BoundVariable & operator=(const T &value) { set(value); return *this; }
+};
+
 struct Variable;
 
 class Let {
@@ -936,6 +3115,15 @@ public:
 
     s7_pointer ptr() const { return let; }
 
+    template <typename T>
+    std::optional<T> to_opt(s7_pointer p)
+    {
+        if (!detail::is<T>(sc, p)) {
+            return std::nullopt;
+        }
+        return detail::to<T>(sc, p);
+    }
+
     template <typename T> s7_pointer define(std::string_view name, const T &value, std::string_view doc = "")
     {
         auto object = detail::from(sc, value);
@@ -945,6 +3133,15 @@ public:
         return sym;
     }
 
+    template <fixed_string Name, typename T> s7_pointer define(Symbol<Name>, T &&value, std::string_view doc = "")
+    {
+        auto object = detail::from(sc, FWD(value));
+        auto sym = detail::symbol<Name>(sc);
+        s7_define(sc, let, sym, object);
+        s7_set_documentation(sc, sym, doc.data());
+        return sym;
+    }
+
     template <typename T> s7_pointer define(std::string_view name, T &&value, std::string_view doc = "")
     {
         auto object = detail::from(sc, std::move(value));
@@ -971,74 +3168,692 @@ public:
     }
 
     Variable operator[](std::string_view name);
+    template <fixed_string Name> Variable operator[](Symbol<Name>);
 
-    template <typename T> T get(std::string_view name)        { return to<T>(s7_let_ref(sc, let, s7_make_symbol(sc, name.data()))); }
+    template <typename T> BoundVariable<T> variable(std::string_view name)          { return BoundVariable<T>(sc, let, s7_make_symbol(sc, std::string(name).c_str())); }
+    template <typename T, fixed_string Name> BoundVariable<T> variable(Symbol<Name>) { return BoundVariable<T>(sc, let, detail::symbol<Name>(sc)); }
+
+    template <typename T> T get(std::string_view name)        { return detail::to<T>(sc, s7_let_ref(sc, let, s7_make_symbol(sc, name.data()))); }
     template <typename T> auto get_opt(std::string_view name) { return to_opt<T>(s7_let_ref(sc, let, s7_make_symbol(sc, name.data()))); }
+    template <typename T, fixed_string Name> T get(Symbol<Name>)        { return detail::to<T>(sc, s7_let_ref(sc, let, detail::symbol<Name>(sc))); }
+    template <typename T, fixed_string Name> auto get_opt(Symbol<Name>) { return to_opt<T>(s7_let_ref(sc, let, detail::symbol<Name>(sc))); }
+
+    template <typename T> void set(std::string_view name, T &&value) { s7_let_set(sc, let, s7_make_symbol(sc, name.data()), detail::from(sc, FWD(value))); }
+    template <fixed_string Name, typename T> void set(Symbol<Name>, T &&value) { s7_let_set(sc, let, detail::symbol<Name>(sc), detail::from(sc, FWD(value))); }
+
+    List to_list() const { return List(s7_let_to_list(sc, let)); }
+
+    template <typename F>
+    s7_pointer define_function(std::string_view name, std::string_view doc, F &&fn, FunctionOpts opts = {})
+    {
+        auto f = detail::make_function(sc, name, doc, std::move(fn), opts);
+        define(name, f.ptr(), doc);
+        return f.ptr();
+    }
+
+    template <typename F>
+    void define_star_function(std::string_view name, std::string_view arglist_desc, std::string_view doc, F &&fn)
+    {
+        auto f = detail::make_star_function(sc, name, arglist_desc, doc, std::move(fn));
+        define(name, f.ptr(), doc);
+    }
+};
+
+// a typed, owning handle to a scheme procedure, for calling it from C++. the
+// procedure is kept protected from the GC together with a preallocated
+// argument list, so a call only converts arguments and result. functions
+// bound with define_function can take one as an argument (the procedure is
+// checked with procedure?), and Scheme::prepare() makes one from a name.
+template <typename R, typename... Args>
+class Callable<R(Args...)> {
+    s7_scheme *sc;
+    s7_pointer fn;
+    s7_pointer args;
+    s7_int fn_loc;
+    s7_int args_loc;
+    // the outermost Entry (see Running) of the call using args, 0 when there's
+    // none. a scheme error caught outside the call longjmps past the reset,
+    // and then args is only taken again from the next outermost Entry on
+    std::uint64_t busy_in = 0;
+
+    void fill(s7_pointer arglist, Args... values)
+    {
+        [[maybe_unused]] auto p = arglist;
+        ((s7_set_car(p, detail::from(sc, std::forward<Args>(values))), p = s7_cdr(p)), ...);
+    }
+
+public:
+    Callable(s7_scheme *sc, Function fn)
+        : sc(sc), fn(fn.ptr()), args(s7_make_list(sc, sizeof...(Args), s7_nil(sc)))
+    {
+        fn_loc = s7_gc_protect(sc, this->fn);
+        args_loc = s7_gc_protect(sc, args);
+    }
+
+    Callable(const Callable &) = delete;
+    Callable & operator=(const Callable &) = delete;
+
+    Callable(Callable &&other)
+        : sc(std::exchange(other.sc, nullptr)), fn(other.fn), args(other.args),
+          fn_loc(other.fn_loc), args_loc(other.args_loc) {}
+
+    Callable & operator=(Callable &&other)
+    {
+        std::swap(sc, other.sc);
+        std::swap(fn, other.fn);
+        std::swap(args, other.args);
+        std::swap(fn_loc, other.fn_loc);
+        std::swap(args_loc, other.args_loc);
+        return *this;
+    }
+
+    ~Callable()
+    {
+        if (sc) {
+            s7_gc_unprotect_at(sc, fn_loc);
+            s7_gc_unprotect_at(sc, args_loc);
+        }
+    }
+
+    s7_pointer ptr() const { return fn; }
+
+    R operator()(Args... values)
+    {
+        detail::Entry entry(sc);
+        s7_pointer res;
+        if (busy_in != detail::Running::outermost) {
+            fill(args, std::forward<Args>(values)...);
+            busy_in = detail::Running::outermost;
+            res = s7_call(sc, fn, args);
+            busy_in = 0;
+        } else {
+            // called again from inside the procedure: the shared list is still in use
+            auto arglist = s7_gc_protect_via_stack(sc, s7_make_list(sc, sizeof...(Args), s7_nil(sc)));
+            fill(arglist, std::forward<Args>(values)...);
+            res = s7_call(sc, fn, arglist);
+            s7_gc_unprotect_via_stack(sc, arglist);
+        }
+        if constexpr(!std::is_void_v<R>) {
+            return detail::to<R>(sc, res);
+        }
+    }
+};
+
+// a float-valued expression over variables set from C++, such as
+// (* k (+ x y)) over x, y and k. s7_float_optimize turns it into a tree of
+// direct C calls reading the variables' slots; if the optimizer rejects the
+// expression, it's evaluated normally in a let holding the variables. the
+// compiled code lives in a buffer shared by the whole interpreter, which any
+// later evaluation may reuse, so it's compiled again when the interpreter
+// has been entered (or another expression compiled) since the last call or
+// batch. code that evaluates through the s7 API directly, not through
+// Scheme, leaves that unnoticed. an exception thrown by a C++ function called
+// from the compiled code reaches the caller as is; in an evaluation it's a
+// scheme error.
+class FloatExpr {
+    s7_scheme *sc;
+    s7_pointer code;
+    s7_pointer let;
+    s7_pointer cells;
+    s7_int code_loc;
+    s7_int let_loc;
+    s7_int cells_loc;
+    std::vector<s7_pointer> slots;
+    bool accepted = false;
+    s7_float_function fn = nullptr;
+    // the interpreter's entries when fn was compiled
+    std::uint64_t fn_entries = 0;
+
+    s7_float_function compile()
+    {
+        auto old = s7_set_curlet(sc, let);
+        auto f = s7_float_optimize(sc, code);
+        s7_set_curlet(sc, old);
+        // the buffer now holds this expression, whoever compiled into it before
+        fn_entries = ++detail::instance_id(sc).inst->entries;
+        return f;
+    }
+
+    // fn, compiled again if the interpreter may have reused its buffer
+    s7_float_function compiled()
+    {
+        if (!fn || fn_entries != detail::instance_id(sc).inst->entries) {
+            fn = compile();
+        }
+        return fn;
+    }
 
-    template <typename T> void set(std::string_view name, const T  &value) { s7_let_set(sc, s7_make_symbol(sc, name.data()), from(value)); }
-    template <typename T> void set(std::string_view name,       T &&value) { s7_let_set(sc, s7_make_symbol(sc, name.data()), from(std::move(value))); }
+    // the compiled code reads the variables in place, from mutable reals
+    void set_in_place(std::size_t i, double x)
+    {
+        auto cell = s7_vector_ref(sc, cells, s7_int(i));
+        if (s7_slot_value(slots[i]) == cell) {
+            s7_slot_set_real_value(sc, slots[i], x);
+        } else {
+            s7_slot_set_value(sc, slots[i], s7_vector_set(sc, cells, s7_int(i), s7_make_mutable_real(sc, x)));
+            fn = nullptr;
+        }
+    }
+
+    // eval may hold on to the values, so these get fresh ones
+    void set_boxed(std::size_t i, double x)
+    {
+        s7_slot_set_value(sc, slots[i], s7_make_real(sc, x));
+    }
+
+    double eval() { return s7_number_to_real(sc, s7_eval(sc, s7_car(code), let)); }
+
+public:
+    FloatExpr(s7_scheme *sc, s7_pointer expr, std::initializer_list<std::string_view> vars)
+        : sc(sc)
+    {
+        // the extra list is what s7_float_optimize expects
+        code = s7_list(sc, 1, expr);
+        code_loc = s7_gc_protect(sc, code);
+        let = s7_sublet(sc, s7_rootlet(sc), s7_nil(sc));
+        let_loc = s7_gc_protect(sc, let);
+        cells = s7_make_vector(sc, s7_int(vars.size()));
+        cells_loc = s7_gc_protect(sc, cells);
+        auto old = s7_set_curlet(sc, let);
+        for (auto i = 0u; auto var : vars) {
+            auto sym = s7_make_symbol(sc, std::string(var).c_str());
+            s7_define(sc, let, sym, s7_vector_set(sc, cells, i++, s7_make_mutable_real(sc, 0.0)));
+            slots.push_back(s7_slot(sc, sym));
+        }
+        s7_set_curlet(sc, old);
+        fn = compile();
+        accepted = fn != nullptr;
+    }
+
+    FloatExpr(const FloatExpr &) = delete;
+    FloatExpr & operator=(const FloatExpr &) = delete;
+
+    FloatExpr(FloatExpr &&other)
+        : sc(std::exchange(other.sc, nullptr)), code(other.code), let(other.let), cells(other.cells),
+          code_loc(other.code_loc), let_loc(other.let_loc), cells_loc(other.cells_loc),
+          slots(std::move(other.slots)), accepted(other.accepted), fn(other.fn), fn_entries(other.fn_entries) {}
+
+    FloatExpr & operator=(FloatExpr &&other)
+    {
+        std::swap(sc, other.sc);
+        std::swap(code, other.code);
+        std::swap(let, other.let);
+        std::swap(cells, other.cells);
+        std::swap(code_loc, other.code_loc);
+        std::swap(let_loc, other.let_loc);
+        std::swap(cells_loc, other.cells_loc);
+        std::swap(slots, other.slots);
+        std::swap(accepted, other.accepted);
+        std::swap(fn, other.fn);
+        std::swap(fn_entries, other.fn_entries);
+        return *this;
+    }
+
+    ~FloatExpr()
+    {
+        if (sc) {
+            s7_gc_unprotect_at(sc, code_loc);
+            s7_gc_unprotect_at(sc, let_loc);
+            s7_gc_unprotect_at(sc, cells_loc);
+        }
+    }
+
+    // whether the optimizer took the expression (otherwise every call is an eval)
+    bool optimized() const { return accepted; }
+
+    // values in the same order as the variable names
+    double operator()(std::span<const double> values)
+    {
+#if S7_DEBUGGING
+        assert(values.size() == slots.size() && "wrong number of values");
+#endif
+        if (accepted) {
+            for (std::size_t i = 0; i < values.size(); i++) {
+                set_in_place(i, values[i]);
+            }
+            if (auto f = compiled(); f) {
+                detail::DirectCall direct;
+                return f(sc);
+            }
+        }
+        for (std::size_t i = 0; i < values.size(); i++) {
+            set_boxed(i, values[i]);
+        }
+        detail::Entry entry(sc);
+        return eval();
+    }
+
+    template <typename... Ts>
+    double operator()(Ts... values)
+    {
+        auto arr = std::array<double, sizeof...(Ts)> { static_cast<double>(values)... };
+        return (*this)(std::span<const double>(arr));
+    }
+
+    // evaluates the expression once per row, with one column per variable
+    template <typename... Cols>
+    void map_into(std::span<double> out, Cols... columns)
+    {
+        constexpr auto NumCols = sizeof...(Cols);
+        auto cols = std::array<std::span<const double>, NumCols> { std::span<const double>(columns)... };
+#if S7_DEBUGGING
+        assert(NumCols == slots.size() && "wrong number of columns");
+        for (auto col : cols) {
+            assert(col.size() >= out.size() && "column shorter than output");
+        }
+#endif
+        if (accepted) {
+            for (std::size_t j = 0; j < NumCols; j++) {
+                set_in_place(j, 0.0);
+            }
+            if (auto f = compiled(); f) {
+                detail::DirectCall direct;
+                for (std::size_t i = 0; i < out.size(); i++) {
+                    for (std::size_t j = 0; j < NumCols; j++) {
+                        set_in_place(j, cols[j][i]);
+                    }
+                    out[i] = f(sc);
+                }
+                return;
+            }
+        }
+        detail::Entry entry(sc);
+        for (std::size_t i = 0; i < out.size(); i++) {
+            for (std::size_t j = 0; j < NumCols; j++) {
+                set_boxed(j, cols[j][i]);
+            }
+            out[i] = eval();
+        }
+    }
+};
+
+namespace detail {
+    // builds (lambda (out n cols...) (do ((i 0 (+ i 1))) ((= i n) out) (float-vector-set! out i expr)))
+    // with each free reference to a column name in expr replaced by a read of
+    // the column at row i. reading the columns directly, rather than binding
+    // their names with let, is what lets s7's loop optimizer compile the body.
+    // the walk knows calls and the usual special forms; for anything else
+    // (macros, set!, define, ...) it can't tell which references are free,
+    // and the columns are bound with let around expr after all. (gensym
+    // would be the obvious source of names, but it touches state shared by
+    // all instances.) the maker is evaluated once per interpreter, and gets
+    // expr as read and the names as symbols.
+    inline s7_pointer column_loop_maker(s7_scheme *sc)
+    {
+        return internal_value<"column-loop-maker">(sc, [&] {
+            auto maker = s7_eval_c_string(sc, R"((lambda (expr names ints)
+            (let* ((name (lambda (s) (string->symbol (string-append "{eval-columns}-" s))))
+                   (out (name "out")) (n (name "n")) (i (name "i"))
+                   (cols (map (lambda (col) (name (symbol->string col))) names))
+                   (refs (map (lambda (name col int?)
+                                (cons name (list (if int? 'int-vector-ref 'float-vector-ref) col i)))
+                              names cols ints))
+                   (params (lambda (ps)
+                             (let loop ((ps ps))
+                               (cond ((symbol? ps) (list ps))
+                                     ((pair? ps) (cons (car ps) (loop (cdr ps))))
+                                     (else ())))))
+                   (body (call-with-exit
+                          (lambda (give-up)
+                            (let walk ((x expr) (bound ()))
+                              (define (walk-all xs) (map (lambda (x) (walk x bound)) xs))
+                              (cond ((symbol? x)
+                                     (cond ((memq x bound) x) ((assq x refs) => cdr) (else x)))
+                                    ((not (pair? x)) x)
+                                    ((not (list? x)) (give-up #f))
+                                    ((or (not (symbol? (car x))) (memq (car x) bound)) (walk-all x))
+                                    (else
+                                     (case (car x)
+                                       ((quote) x)
+                                       ((if when unless begin and or) (cons (car x) (walk-all (cdr x))))
+                                       ((cond) (cons 'cond (map walk-all (cdr x))))
+                                       ((lambda)
+                                        (let ((inner (append (params (cadr x)) bound)))
+                                          (cons 'lambda (cons (cadr x) (map (lambda (b) (walk b inner)) (cddr x))))))
+                                       ((let let*)
+                                        (if (symbol? (cadr x)) (give-up #f))
+                                        (let loop ((bs (cadr x)) (inner bound) (acc ()))
+                                          (if (null? bs)
+                                              (cons (car x) (cons (reverse acc) (map (lambda (b) (walk b inner)) (cddr x))))
+                                              (let ((b (car bs)))
+                                                (if (not (and (pair? b) (symbol? (car b)) (pair? (cdr b)))) (give-up #f))
+                                                (loop (cdr bs) (cons (car b) inner)
+                                                      (cons (list (car b) (walk (cadr b) (if (eq? (car x) 'let*) inner bound))) acc))))))
+                                       (else
+                                        (if (procedure? (symbol->value (car x) (rootlet)))
+                                            (walk-all x)
+                                            (give-up #f))))))))))
+                   (body (or body
+                             `(let ,(map (lambda (ref) (list (car ref) (cdr ref))) refs) ,expr))))
+              (eval `(lambda (,out ,n ,@cols)
+                       (do ((,i 0 (+ ,i 1))) ((= ,i ,n) ,out)
+                         (float-vector-set! ,out ,i ,body)))
+                    (rootlet)))))");
+            s7_gc_protect(sc, maker);
+            return maker;
+        });
+    }
+
+    inline s7_pointer make_column_loop(s7_scheme *sc, std::string_view expr, std::span<const Column> columns)
+    {
+        // (expr names ints), with the lists built back to front
+        auto args = s7_make_list(sc, 3, s7_nil(sc));
+        auto args_loc = s7_gc_protect(sc, args);
+        s7_set_car(args, read_datum(sc, expr));
+        auto names = s7_cdr(args), ints = s7_cddr(args);
+        for (auto j = columns.size(); j-- > 0;) {
+            s7_set_car(names, s7_cons(sc, s7_make_symbol(sc, std::string(columns[j].name).c_str()), s7_car(names)));
+            s7_set_car(ints, s7_cons(sc, s7_make_boolean(sc, columns[j].integer), s7_car(ints)));
+        }
+        auto loop = s7_call(sc, column_loop_maker(sc), args);
+        s7_gc_unprotect_at(sc, args_loc);
+        return loop;
+    }
+
+    // evaluates rows [begin, end) chunk by chunk, returns false if the expression raised an error
+    inline bool eval_column_rows(s7_scheme *sc, std::string_view expr, std::span<const Column> columns,
+                                 std::span<double> out, std::size_t begin, std::size_t end, std::size_t chunk_size)
+    {
+        Entry entry(sc);
+        auto loop = make_column_loop(sc, expr, columns);
+        if (!s7_is_procedure(loop)) {
+            return false;
+        }
+        auto loop_loc = s7_gc_protect(sc, loop);
+        // (out n cols...), refilled for each chunk
+        auto args = s7_make_list(sc, s7_int(columns.size() + 2), s7_nil(sc));
+        auto args_loc = s7_gc_protect(sc, args);
+        // float columns are wrapped in place, but s7 can't wrap integer arrays,
+        // so those are copied one chunk at a time
+        auto buffers = s7_make_vector(sc, s7_int(columns.size()));
+        auto buffers_loc = s7_gc_protect(sc, buffers);
+        for (std::size_t j = 0; j < columns.size(); j++) {
+            if (columns[j].integer) {
+                s7_vector_set(sc, buffers, s7_int(j), s7_make_int_vector(sc, s7_int(chunk_size), 1, nullptr));
+            }
+        }
+
+        auto wrap = [&](const double *data, std::size_t n) {
+            // the loop only reads input columns
+            return s7_make_float_vector_wrapper(sc, s7_int(n), const_cast<double *>(data), 1, nullptr, false);
+        };
+
+        bool ok = true;
+        for (auto row = begin; ok && row < end; row += chunk_size) {
+            auto n = std::min(chunk_size, end - row);
+            auto p = args;
+            auto out_vec = s7_set_car(p, wrap(out.data() + row, n));
+            p = s7_cdr(p);
+            s7_set_car(p, s7_make_integer(sc, s7_int(n)));
+            p = s7_cdr(p);
+            for (std::size_t j = 0; j < columns.size(); j++, p = s7_cdr(p)) {
+                if (columns[j].integer) {
+                    auto buffer = s7_vector_ref(sc, buffers, s7_int(j));
+                    std::copy_n(columns[j].ints.data() + row, n, s7_int_vector_elements(buffer));
+                    s7_set_car(p, buffer);
+                } else {
+                    s7_set_car(p, wrap(columns[j].reals.data() + row, n));
+                }
+            }
+            ok = s7_call(sc, loop, args) == out_vec;
+        }
+
+        s7_gc_unprotect_at(sc, buffers_loc);
+        s7_gc_unprotect_at(sc, args_loc);
+        s7_gc_unprotect_at(sc, loop_loc);
+        return ok;
+    }
+
+    template <typename T>
+    void push_field(s7_scheme *sc, s7_pointer slot, void *field)
+    {
+        const auto &value = *static_cast<T *>(field);
+        if constexpr(std::is_floating_point_v<T>) {
+            auto cur = s7_slot_value(slot);
+            if (s7_is_real(cur) && !s7_is_rational(cur) && s7_real(cur) == value) {
+                return;
+            }
+        } else if constexpr(std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+            auto cur = s7_slot_value(slot);
+            if (s7_is_integer(cur) && s7_integer(cur) == s7_int(value)) {
+                return;
+            }
+        }
+        s7_slot_set_value(sc, slot, from(sc, value));
+    }
+
+    template <typename T>
+    bool pull_field(s7_scheme *sc, void *field, s7_pointer value)
+    {
+        if (!is<T>(sc, value)) {
+            return false;
+        }
+        *static_cast<T *>(field) = to<T>(sc, value);
+        return true;
+    }
+
+    inline s7_pointer live_field_setter(s7_scheme *sc, s7_pointer args)
+    {
+        auto sym = s7_car(args);
+        auto value = s7_cadr(args);
+        std::string_view type;
+        if (auto fields = find_live_fields(sc); fields) {
+            for (const auto &f : *fields) {
+                if (f.sym == sym) {
+                    if (f.pull(sc, f.field, value)) {
+                        return value;
+                    }
+                    type = f.type;
+                    break;
+                }
+            }
+        }
+        return s7_wrong_type_arg_error(sc, s7_symbol_name(sym), 2, value, type.data());
+    }
+
+    inline void release_live_fields(s7_scheme *sc)
+    {
+        std::lock_guard<std::mutex> lock(LiveFields::mutex);
+        LiveFields::fields.erase(reinterpret_cast<uintptr_t>(sc));
+    }
+
+    // usertype operators go through s7's own methods: objects of a type with
+    // method ops are opened, so a builtin like + only looks in the type's let
+    // after meeting one of them, and arithmetic on numbers never notices.
+    // the let maps the operator to method_op_dispatch and keeps the c++
+    // function under method_op_key (- can have both a binary and a unary one)
+    template <MethodOp op>
+    s7_pointer method_op_symbol(s7_scheme *sc)
+    {
+        if constexpr(op == MethodOp::Add) { return symbol<"+">(sc);   }
+        if constexpr(op == MethodOp::Sub) { return symbol<"-">(sc);   }
+        if constexpr(op == MethodOp::Mul) { return symbol<"*">(sc);   }
+        if constexpr(op == MethodOp::Div) { return symbol<"/">(sc);   }
+        if constexpr(op == MethodOp::Lt)  { return symbol<"<">(sc);   }
+        if constexpr(op == MethodOp::Gt)  { return symbol<">">(sc);   }
+        if constexpr(op == MethodOp::Leq) { return symbol<"<=">(sc);  }
+        if constexpr(op == MethodOp::Geq) { return symbol<">=">(sc);  }
+        if constexpr(op == MethodOp::Eq)  { return symbol<"=">(sc);   }
+        if constexpr(op == MethodOp::Abs) { return symbol<"abs">(sc); }
+        if constexpr(op == MethodOp::Neg) { return symbol<"-">(sc);   }
+    }
+
+    template <MethodOp op>
+    s7_pointer method_op_key(s7_scheme *sc)
+    {
+        if constexpr(op == MethodOp::Add) { return symbol<"method +">(sc);   }
+        if constexpr(op == MethodOp::Sub) { return symbol<"method -">(sc);   }
+        if constexpr(op == MethodOp::Mul) { return symbol<"method *">(sc);   }
+        if constexpr(op == MethodOp::Div) { return symbol<"method /">(sc);   }
+        if constexpr(op == MethodOp::Lt)  { return symbol<"method <">(sc);   }
+        if constexpr(op == MethodOp::Gt)  { return symbol<"method >">(sc);   }
+        if constexpr(op == MethodOp::Leq) { return symbol<"method <=">(sc);  }
+        if constexpr(op == MethodOp::Geq) { return symbol<"method >=">(sc);  }
+        if constexpr(op == MethodOp::Eq)  { return symbol<"method =">(sc);   }
+        if constexpr(op == MethodOp::Abs) { return symbol<"method abs">(sc); }
+        if constexpr(op == MethodOp::Neg) { return symbol<"method neg">(sc); }
+    }
+
+    template <MethodOp op>
+    constexpr bool is_comparison_op = op == MethodOp::Lt  || op == MethodOp::Gt || op == MethodOp::Leq
+                                   || op == MethodOp::Geq || op == MethodOp::Eq;
+
+    // args has one or two elements: the function of the first c-object's type
+    // gets them unchanged, or the builtin does if there's none (e.g. in the
+    // middle of (+ v 1 2))
+    template <MethodOp op>
+    s7_pointer method_op_call(s7_scheme *sc, s7_pointer args)
+    {
+        auto a = s7_car(args);
+        auto obj = s7_is_c_object(a) || !s7_is_pair(s7_cdr(args)) ? a : s7_cadr(args);
+        if (!s7_is_c_object(obj)) {
+            return s7_call(sc, s7_symbol_initial_value(method_op_symbol<op>(sc)), args);
+        }
+        auto fn = s7_symbol_local_value(sc, method_op_key<op>(sc), s7_c_object_let(obj));
+        if (!s7_is_procedure(fn)) {
+            return s7_wrong_type_arg_error(sc, method_op_fn<op>().data(), obj == a ? 1 : 2, obj,
+                                           "an object whose type defines this operator");
+        }
+        return s7_call(sc, fn, args);
+    }
+
+    template <MethodOp op>
+    s7_pointer method_op_dispatch(s7_scheme *sc, s7_pointer args)
+    {
+        if (!s7_is_pair(s7_cdr(args))) {
+                 if constexpr(op == MethodOp::Sub)    { return method_op_call<MethodOp::Neg>(sc, args); }
+            else if constexpr(op == MethodOp::Abs)    { return method_op_call<MethodOp::Abs>(sc, args); }
+            else if constexpr(op == MethodOp::Div)    { return s7_wrong_type_arg_error(sc, "/", 1, s7_car(args), "a number"); }
+            else if constexpr(is_comparison_op<op>)   { return s7_t(sc); }
+            else                                      { return s7_car(args); }
+        }
+        if (!s7_is_pair(s7_cddr(args))) {
+            return method_op_call<op>(sc, args);
+        }
+        // longer calls are done a pair at a time
+        if constexpr(is_comparison_op<op>) {
+            for (auto p = args; s7_is_pair(s7_cdr(p)); p = s7_cdr(p)) {
+                if (method_op_call<op>(sc, s7_list(sc, 2, s7_car(p), s7_cadr(p))) == s7_f(sc)) {
+                    return s7_f(sc);
+                }
+            }
+            return s7_t(sc);
+        } else {
+            auto res = s7_car(args);
+            for (auto p = s7_cdr(args); s7_is_pair(p); p = s7_cdr(p)) {
+                s7_gc_protect_via_stack(sc, res);
+                auto pair = s7_list(sc, 2, res, s7_car(p));
+                s7_gc_unprotect_via_stack(sc, res);
+                res = method_op_call<op>(sc, pair);
+            }
+            return res;
+        }
+    }
+
+    template <MethodOp op, typename F>
+    void define_method_op(s7_scheme *sc, std::string_view type_name, s7_pointer let, F &&fn)
+    {
+        constexpr auto dispatch_op = op == MethodOp::Neg ? MethodOp::Sub : op;
+        auto name = std::format("{} ({} method)", method_op_fn<op>(), type_name);
+        auto method = make_function(sc, name, "custom method for usertype", std::move(fn), {});
+        s7_define(sc, let, method_op_key<op>(sc), method.ptr());
+        s7_define(sc, let, method_op_symbol<op>(sc),
+                  s7_make_safe_function(sc, method_op_fn<op>().data(), method_op_dispatch<dispatch_op>, 1, 0, true,
+                                        "dispatches to a usertype's method or to the builtin"));
+    }
+
+    // objects made before this won't be open, so method ops are best added
+    // right after make_usertype
+    template <typename T>
+    void open_type_objects(s7_scheme *sc)
+    {
+        auto info = get_type_info<T>(sc);
+        info.open = true;
+        set_type_info<T>(sc, info);
+    }
 
-    List to_list() const { return List(s7_let_to_list(sc, let)); }
+    /*
+     * a checked call goes through (lambda (f a) (catch #t (lambda () (apply f a)) handler)),
+     * made once per interpreter, with handler a c function that records the
+     * error. (s7_call_with_catch() can't be used: called from inside a c
+     * function, it goes on evaluating the caller's code after the handler.)
+     * a nested checked call is done by the time its caller's handler runs,
+     * so the error only has to be kept until the call returns.
+     */
+    struct CheckedCall {
+        static inline thread_local bool failed = false;
+        static inline thread_local s7_pointer type = nullptr;
+        static inline thread_local s7_pointer info = nullptr;
+        // calls running on this thread, which may be using the shared arglist
+        static inline thread_local int depth = 0;
+    };
 
-    template <typename F>
-    s7_pointer define_function(std::string_view name, std::string_view doc, F &&fn, FunctionOpts opts = {})
+    inline s7_pointer checked_call_handler(s7_scheme *sc, s7_pointer args)
     {
-        auto f = detail::make_function(sc, name, doc, std::move(fn), opts);
-        define(name, f.ptr(), doc);
-        return f.ptr();
+        CheckedCall::failed = true;
+        CheckedCall::type = s7_car(args);
+        CheckedCall::info = s7_cadr(args);
+        return s7_unspecified(sc);
     }
 
-    template <typename F>
-    void define_star_function(std::string_view name, std::string_view arglist_desc, std::string_view doc, F &&fn)
+    inline s7_pointer checked_call_closure(s7_scheme *sc)
     {
-        auto f = detail::make_star_function(sc, name, arglist_desc, doc, std::move(fn));
-        define(name, f.ptr(), doc);
+        return internal_value<"checked-call">(sc, [&] {
+            auto handler = s7_make_function(sc, "checked-call-handler", checked_call_handler, 2, 0, false, "records the error for call_checked()");
+            auto make = s7_eval_c_string(sc, "(lambda (handler) (lambda (f a) (catch #t (lambda () (apply f a)) handler)))");
+            auto closure = s7_call(sc, make, s7_list(sc, 1, handler));
+            s7_gc_protect(sc, closure);
+            return closure;
+        });
     }
-};
 
-class Scheme {
-    s7_scheme *sc;
-    // NOTE: any following field can't be accessed inside non-capturing lambdas
-    std::unordered_set<MethodOp> substitured_ops;
+    // (fn args) for the closure, refilled by each call
+    inline s7_pointer checked_call_arglist(s7_scheme *sc)
+    {
+        return internal_value<"checked-call-args">(sc, [&] {
+            auto arglist = s7_list(sc, 2, s7_nil(sc), s7_nil(sc));
+            s7_gc_protect(sc, arglist);
+            return arglist;
+        });
+    }
 
-    template <MethodOp op>
-    auto make_method_op_function()
-    {
-        auto old = Function(s7_name_to_value(sc, method_op_fn<op>().data()));
-        return [this, old](VarArgs<s7_pointer> args) -> s7_pointer {
-            constexpr auto Name = method_op_fn<op>();
-            if (args.size() == 0) {
-                return call(old, nil());
-            } else if (args.size() == 0) {
-                auto p = args.car();
-                if (s7_is_c_object(p)) {
-                    auto method = find_method(s7_c_object_let(p), Name);
-                    if (!method) {
-                        auto msg = std::format("a c-object that defines {}", Name);
-                        return s7_wrong_type_arg_error(sc, Name.data(), 0, p, msg.c_str());
-                    }
-                    return call(method.value(), p);
-                } else {
-                    return call(old, p);
-                }
-            }
-            auto res = args.advance();
-            for (auto arg : args) {
-                if (s7_is_c_object(res) || s7_is_c_object(arg)) {
-                    auto p = s7_is_c_object(res) ? res : arg;
-                    auto method = find_method(s7_c_object_let(p), Name);
-                    if (!method) {
-                        return s7_wrong_type_arg_error(sc, Name.data(), 0, res, "a c-object that defines +");
-                    }
-                    res = call(method.value(), res, arg);
-                } else {
-                    res = call(old, res, arg);
-                }
-            }
+#ifdef __cpp_lib_expected
+    inline std::expected<s7_pointer, errors::Error> call_checked(s7_scheme *sc, s7_pointer fn, s7_pointer args)
+    {
+        auto closure = checked_call_closure(sc);
+        s7_pointer call_args;
+        if (CheckedCall::depth == 0) {
+            call_args = checked_call_arglist(sc);
+            s7_set_car(call_args, fn);
+            s7_set_car(s7_cdr(call_args), args);
+        } else {
+            // called from inside another call_checked(), whose list may be in use
+            auto loc = s7_gc_protect(sc, args);
+            call_args = s7_list(sc, 2, fn, args);
+            s7_gc_unprotect_at(sc, loc);
+        }
+        CheckedCall::depth++;
+        auto res = s7_call(sc, closure, call_args);
+        CheckedCall::depth--;
+        if (CheckedCall::depth == 0) {
+            // so that they can be collected
+            s7_set_car(call_args, s7_nil(sc));
+            s7_set_car(s7_cdr(call_args), s7_nil(sc));
+        }
+        if (!std::exchange(CheckedCall::failed, false)) {
             return res;
-        };
+        }
+        auto type = CheckedCall::type;
+        return std::unexpected(errors::Error {
+            .type = s7_is_symbol(type) ? std::string_view(s7_symbol_name(type)) : std::string_view("error"),
+            .info = List(CheckedCall::info),
+        });
     }
+#endif
+} // namespace detail
 
+class Scheme {
+    s7_scheme *sc;
     template <typename T, typename F>
     void usertype_add_op(std::string_view name, s7_int tag, Op op, F &&fn)
         requires (std::is_same_v<T,          std::remove_cvref_t<typename FunctionTraits<F>::Argument<0>::Type>>
@@ -1068,12 +3883,12 @@ class Scheme {
                     s7_mark(obj_let);
                     fn2(*reinterpret_cast<T *>(s7_c_object_value(obj)));
                     return nullptr;
-                });
+                }).c_function();
             } else {
-                f = detail::make_s7_function(sc, _name, fn);
+                f = detail::make_s7_function(sc, _name, fn).c_function();
             }
         } else {
-            f = detail::make_s7_function(sc, _name, fn);
+            f = detail::make_s7_function(sc, _name, fn).c_function();
         }
         set_func(sc, tag, f);
     }
@@ -1081,24 +3896,20 @@ class Scheme {
     template <typename T, typename F>
     void usertype_add_method_op(std::string_view name, s7_pointer let, MethodOp op, F &&fn)
     {
-        auto opname = op == MethodOp::Add ? "+"
-                    : op == MethodOp::Sub ? "-"
-                    : op == MethodOp::Mul ? "*"
-                    : op == MethodOp::Div ? "/"
-                    : "";
-        // put fn as a method
-        auto _name = std::format("{} ({} method)", opname, name);
-        Function add_method = make_function(_name, "custom method for usertype", std::move(fn));
-        Let(sc, let).define(opname, add_method);
-        // substitute op
-        if (!substitured_ops.contains(op)) {
-            auto doc = s7_documentation(sc, s7_name_to_value(sc, opname));
-                 if (op == MethodOp::Add) { define_function(opname, doc, make_method_op_function<MethodOp::Add>()); }
-            else if (op == MethodOp::Sub) { define_function(opname, doc, make_method_op_function<MethodOp::Sub>()); }
-            else if (op == MethodOp::Mul) { define_function(opname, doc, make_method_op_function<MethodOp::Mul>()); }
-            else if (op == MethodOp::Div) { define_function(opname, doc, make_method_op_function<MethodOp::Div>()); }
-            substitured_ops.insert(op);
+        switch (op) {
+        case MethodOp::Add: detail::define_method_op<MethodOp::Add>(sc, name, let, FWD(fn)); break;
+        case MethodOp::Sub: detail::define_method_op<MethodOp::Sub>(sc, name, let, FWD(fn)); break;
+        case MethodOp::Mul: detail::define_method_op<MethodOp::Mul>(sc, name, let, FWD(fn)); break;
+        case MethodOp::Div: detail::define_method_op<MethodOp::Div>(sc, name, let, FWD(fn)); break;
+        case MethodOp::Lt:  detail::define_method_op<MethodOp::Lt >(sc, name, let, FWD(fn)); break;
+        case MethodOp::Gt:  detail::define_method_op<MethodOp::Gt >(sc, name, let, FWD(fn)); break;
+        case MethodOp::Leq: detail::define_method_op<MethodOp::Leq>(sc, name, let, FWD(fn)); break;
+        case MethodOp::Geq: detail::define_method_op<MethodOp::Geq>(sc, name, let, FWD(fn)); break;
+        case MethodOp::Eq:  detail::define_method_op<MethodOp::Eq >(sc, name, let, FWD(fn)); break;
+        case MethodOp::Abs: detail::define_method_op<MethodOp::Abs>(sc, name, let, FWD(fn)); break;
+        case MethodOp::Neg: detail::define_method_op<MethodOp::Neg>(sc, name, let, FWD(fn)); break;
         }
+        detail::open_type_objects<T>(sc);
     }
 
     using InputFn  = s7_pointer (*)(s7_scheme *sc, s7_read_t read_choice, s7_pointer port);
@@ -1106,33 +3917,33 @@ class Scheme {
 
     InputFn make_input_fn(auto &&fn)
     {
-        auto lambda = detail::as_lambda(fn);
-        using L = std::remove_cvref_t<decltype(lambda)>;
-        detail::set_lambda<L>(sc, std::move(lambda), "an input function");
-        return [](s7_scheme *sc, s7_read_t read_choice, s7_pointer port) -> s7_pointer {
-            auto &fn = detail::LambdaTable<L>::lambda;
-            return fn(*reinterpret_cast<Scheme *>(&sc), InputPort(sc, port), read_choice);
-        };
+        return detail::bind_callable<s7_pointer(s7_scheme *, s7_read_t, s7_pointer), 64>(sc, "an input function", detail::as_lambda(fn),
+            [](auto &fn, detail::Caller, s7_scheme *sc, s7_read_t read_choice, s7_pointer port) -> s7_pointer {
+                return fn(*reinterpret_cast<Scheme *>(&sc), InputPort(sc, port), read_choice);
+            });
     }
 
     OutputFn make_output_fn(auto &&fn)
     {
-        auto lambda = detail::as_lambda(fn);
-        using L = std::remove_cvref_t<decltype(lambda)>;
-        detail::set_lambda<L>(sc, std::move(lambda), "an output function");
-        return [](s7_scheme *sc, uint8_t c, s7_pointer port) -> void {
-            auto &fn = detail::LambdaTable<L>::lambda;
-            fn(*reinterpret_cast<Scheme *>(&sc), OutputPort(sc, port), c);
-        };
+        return detail::bind_callable<void(s7_scheme *, uint8_t, s7_pointer), 64>(sc, "an output function", detail::as_lambda(fn),
+            [](auto &fn, detail::Caller, s7_scheme *sc, uint8_t c, s7_pointer port) -> void {
+                fn(*reinterpret_cast<Scheme *>(&sc), OutputPort(sc, port), c);
+            });
     }
 
 public:
-    Scheme() : sc(s7_init()) {}
+    // (an interpreter that wasn't made here may have had the same address)
+    Scheme() : sc(s7_init()) { detail::end_instance(sc); }
 
     ~Scheme()
     {
         s7_quit(sc);
         s7_free(sc);
+        // after s7_free, since freeing objects may still call bound functions
+        // (which may also cache symbols again)
+        detail::release_bindings(sc);
+        detail::release_live_fields(sc);
+        detail::end_instance(sc);
     }
 
     Scheme(const Scheme &) = delete;
@@ -1145,11 +3956,12 @@ public:
     /* eval, load, repl */
     s7_pointer eval(std::string_view code)
     {
+        detail::Entry entry(sc);
         return s7_eval_c_string(sc, code.data());
     }
 
-    s7_pointer load(std::string_view filepath) { return s7_load(sc, filepath.data()); }
-    s7_pointer load_string(std::string_view string) { return s7_load_c_string(sc, string.data(), string.size()); }
+    s7_pointer load(std::string_view filepath)      { detail::Entry entry(sc); return s7_load(sc, filepath.data()); }
+    s7_pointer load_string(std::string_view string) { detail::Entry entry(sc); return s7_load_c_string(sc, string.data(), string.size()); }
 
     void repl(
         std::function<bool(std::string_view)> quit = [](std::string_view) { return false; },
@@ -1194,7 +4006,7 @@ public:
     template <typename T> bool is(s7_pointer p)         { return s7::detail::is<T>(sc, p); }
     template <typename T> T to(s7_pointer p)            { return s7::detail::to<T>(sc, p); }
     template <typename T> s7_pointer from(const T &obj) { return s7::detail::from(sc, obj); }
-    template <typename T> s7_pointer from(T &&obj)      { return s7::detail::from(sc, std::move(obj)); }
+    template <typename T> s7_pointer from(T &&obj)      { return s7::detail::from(sc, FWD(obj)); }
     bool is_number(s7_pointer p) { return s7_is_number(p); }
     bool is_equal(s7_pointer a, s7_pointer b) { return s7_is_equal(sc, a, b); }
     bool is_equivalent(s7_pointer a, s7_pointer b) { return s7_is_equivalent(sc, a, b); }
@@ -1217,15 +4029,25 @@ public:
     // (list ...)
     List list() { return s7::List(s7_nil(sc)); }
     template <typename T> List list(const T  &arg) { return List(s7_cons(sc, from(arg),            s7_nil(sc))); }
-    template <typename T> List list(      T &&arg) { return List(s7_cons(sc, from(std::move(arg)), s7_nil(sc))); }
+    template <typename T> List list(      T &&arg) { return List(s7_cons(sc, from(FWD(arg)),       s7_nil(sc))); }
     template <typename T, typename... Args> List list(const T  &arg, Args &&...args) { return List(s7_cons(sc, from(arg),            list(FWD(args)...).ptr())); }
-    template <typename T, typename... Args> List list(      T &&arg, Args &&...args) { return List(s7_cons(sc, from(std::move(arg)), list(FWD(args)...).ptr())); }
+    template <typename T, typename... Args> List list(      T &&arg, Args &&...args) { return List(s7_cons(sc, from(FWD(arg)),       list(FWD(args)...).ptr())); }
 
     // (values...)
     Values values(List l)                                     { return Values(s7_values(sc, l.ptr())); }
     template <typename T> Values values(VarArgs<T> l)         { return Values(s7_values(sc, l.ptr())); }
     template <typename... Args> Values values(Args &&...args) { return Values(s7_values(sc, list(FWD(args)...).ptr())); }
 
+    // a float-vector over data that doesn't copy it, valid while the result is alive
+    BorrowedVector borrow(std::span<double> data) { return BorrowedVector(sc, data); }
+
+    template <std::size_t Rank>
+    BorrowedVector borrow(MdSpan<double, Rank> data)
+    {
+        auto dims = detail::mdspan_dims(data);
+        return BorrowedVector(sc, data.flat(), dims);
+    }
+
     // make_c_object
     template <typename T> s7_pointer make_c_object(s7_int tag, T *p) { return detail::make_c_object(sc, tag, p); }
     template <typename T> s7_pointer make_c_object(T *p)             { return make_c_object(detail::get_type_tag<T>(sc), p); }
@@ -1266,30 +4088,212 @@ public:
     }
 
     Variable operator[](std::string_view name);
+    template <fixed_string Name> Variable operator[](Symbol<Name>);
+
+    // see BoundVariable; the variable is looked up (or defined) in the rootlet
+    template <typename T> BoundVariable<T> variable(std::string_view name)            { return BoundVariable<T>(sc, s7_rootlet(sc), sym(name)); }
+    template <typename T, fixed_string Name> BoundVariable<T> variable(Symbol<Name> s) { return BoundVariable<T>(sc, s7_rootlet(sc), sym(s)); }
 
     template <typename T> T get(std::string_view name)        { return to<T>(s7_name_to_value(sc, name.data())); }
     template <typename T> auto get_opt(std::string_view name) { return to_opt<T>(s7_name_to_value(sc, name.data())); }
+    template <typename T, fixed_string Name> T get(Symbol<Name> s)        { return to<T>(s7_symbol_value(sc, sym(s))); }
+    template <typename T, fixed_string Name> auto get_opt(Symbol<Name> s) { return to_opt<T>(s7_symbol_value(sc, sym(s))); }
 
     template <typename T> void set(std::string_view name, const T  &value) { s7_symbol_set_value(sc, sym(name.data()), from(value)); }
     template <typename T> void set(std::string_view name,       T &&value) { s7_symbol_set_value(sc, sym(name.data()), from(std::move(value))); }
+    template <fixed_string Name, typename T> void set(Symbol<Name> s, T &&value) { s7_symbol_set_value(sc, sym(s), from(FWD(value))); }
 
-    s7_pointer sym(std::string_view name) { return s7_make_symbol(sc, name.data()); }
+    s7_pointer sym(std::string_view name) { return s7_make_symbol(sc, std::string(name).c_str()); }
+    template <fixed_string Name> s7_pointer sym(Symbol<Name>) { return detail::symbol<Name>(sc); }
+
+    // makes a C++ variable visible to scheme as a global. set! writes through
+    // to it right away, while C++ writes are seen by scheme as soon as control
+    // goes back to it: when it's entered through eval(), load(), call(),
+    // apply() or a Callable, and when a bound function returns (for other
+    // ways in, call sync_variables()). the variable must outlive the
+    // binding. (s7 has no way to compute a variable's value on read.)
+    template <typename T>
+    void bind_variable(std::string_view name, T *field, std::string_view doc = "")
+    {
+        bind_variable(sym(name), field, doc);
+    }
+
+    template <fixed_string Name, typename T>
+    void bind_variable(Symbol<Name> s, T *field, std::string_view doc = "")
+    {
+        bind_variable(sym(s), field, doc);
+    }
+
+    template <typename T>
+    void bind_variable(s7_pointer s, T *field, std::string_view doc = "")
+    {
+        auto let = s7_rootlet(sc);
+        s7_define(sc, let, s, from(*field));
+        s7_set_documentation(sc, s, doc.data());
+        auto old = s7_set_curlet(sc, let);
+        auto slot = s7_slot(sc, s);
+        s7_set_curlet(sc, old);
+        s7_set_setter(sc, s, s7_make_function(sc, s7_symbol_name(s), detail::live_field_setter, 2, 0, false, "bound variable setter"));
+        detail::add_live_field(sc, {
+            s, slot, field, &detail::push_field<T>, &detail::pull_field<T>, type_to_string<T>()
+        });
+    }
+
+    // copies bound C++ variables into scheme now
+    void sync_variables() { detail::push_live_fields(sc); }
 
     /* calling functions */
     template <typename... T>
     s7_pointer call(std::string_view name, T&&... args)
     {
+        detail::Entry entry(sc);
         return s7_call(sc, s7_name_to_value(sc, name.data()), list(FWD(args)...).ptr());
     }
 
     template <typename... T>
     s7_pointer call(Function func, T&&... args)
     {
+        detail::Entry entry(sc);
         return s7_call(sc, func.ptr(), list(FWD(args)...).ptr());
     }
 
-    s7_pointer apply(Function fn, List list)                             { return s7_apply_function(sc, fn.ptr(), list.ptr()); }
-    template <typename T> s7_pointer apply(Function fn, VarArgs<T> args) { return s7_apply_function(sc, fn.ptr(), args.ptr()); }
+#ifdef __cpp_lib_expected
+    // like call(), but a scheme error (or a C++ exception thrown by a bound
+    // function) comes back as an errors::Error instead of going to the error
+    // hook. the error's info is only valid until the next gc
+    template <typename... T>
+    std::expected<s7_pointer, errors::Error> call_checked(std::string_view name, T&&... args)
+    {
+        return call_checked(Function(s7_name_to_value(sc, name.data())), FWD(args)...);
+    }
+
+    template <typename... T>
+    std::expected<s7_pointer, errors::Error> call_checked(Function func, T&&... args)
+    {
+        detail::Entry entry(sc);
+        return detail::call_checked(sc, func.ptr(), list(FWD(args)...).ptr());
+    }
+#endif
+
+    // like call(), but string arguments aren't copied: they are passed as s7
+    // string wrappers, which are immutable and only valid during the call.
+    // s7 recycles its few wrappers (some builtins, like uncopied substrings,
+    // use them too), so the callee must use the strings right away and never
+    // keep them. good for filters and predicates over transient payloads.
+    template <typename... T>
+    s7_pointer call_borrowed(std::string_view name, T&&... args)
+    {
+        return call_borrowed(Function(s7_name_to_value(sc, name.data())), FWD(args)...);
+    }
+
+    template <typename... T>
+    s7_pointer call_borrowed(Function func, T&&... args)
+    {
+        constexpr auto num_strings = (std::size_t(detail::is_borrowable_string_v<T>) + ... + 0);
+        static_assert(num_strings <= detail::max_borrowed_strings, "too many string arguments for call_borrowed(), use call()");
+        auto arglist = s7_gc_protect_via_stack(sc, s7_make_list(sc, s7_int(sizeof...(T)), s7_f(sc)));
+        std::array<s7_pointer, sizeof...(T)> wrapped;
+        auto p = arglist;
+        std::size_t i = 0;
+        static_cast<void>(((wrapped[i++] = s7_set_car(p, detail::borrow_arg(sc, FWD(args))), p = s7_cdr(p)), ...));
+        detail::Entry entry(sc);
+        auto res = s7_call(sc, func.ptr(), arglist);
+        s7_gc_unprotect_via_stack(sc, arglist);
+#if S7_DEBUGGING
+        i = 0;
+        auto check = [&](const auto &x) {
+            if constexpr(detail::is_borrowable_string_v<decltype(x)>) {
+                assert(s7_string(wrapped[i]) == std::string_view(x).data() && "a borrowed string was recycled during the call");
+            }
+            i++;
+        };
+        (check(args), ...);
+#endif
+        return res;
+    }
+
+    // prepare<void(double)>("on-tick") resolves on-tick once; the handle is called like a function
+    template <typename Sig> Callable<Sig> prepare(std::string_view name) { return Callable<Sig>(sc, Function(s7_name_to_value(sc, std::string(name).c_str()))); }
+    template <typename Sig> Callable<Sig> prepare(Function fn)           { return Callable<Sig>(sc, fn); }
+
+    // compile_float("(* k (+ x y))", {"x", "y", "k"})(1.0, 2.0, 0.5)
+    FloatExpr compile_float(std::string_view expr, std::initializer_list<std::string_view> vars)
+    {
+        return FloatExpr(sc, detail::read_datum(sc, expr), vars);
+    }
+
+    // fills out with expr evaluated once per row, with each column's name
+    // standing for its value at that row: eval_columns("(* k (+ x y))", {
+    // Column("x", xs), Column("y", ys), Column("k", ks) }, out). rows are run
+    // chunk_size at a time through a loop compiled once per call. returns
+    // false if the expression raised an error.
+    bool eval_columns(std::string_view expr, std::span<const Column> columns, std::span<double> out, std::size_t chunk_size = 4096)
+    {
+#if S7_DEBUGGING
+        for (const auto &col : columns) {
+            assert(col.size() >= out.size() && "column shorter than output");
+        }
+#endif
+        return detail::eval_column_rows(sc, expr, columns, out, 0, out.size(), chunk_size);
+    }
+
+    bool eval_columns(std::string_view expr, std::initializer_list<Column> columns, std::span<double> out, std::size_t chunk_size = 4096)
+    {
+        return eval_columns(expr, std::span<const Column>(columns.begin(), columns.size()), out, chunk_size);
+    }
+
+    // calls fn once per element of in, storing the results in out. the GC
+    // protection and the argument list are set up once for the whole batch.
+    template <typename In, typename Out>
+    void map_into(Function fn, std::span<const In> in, std::span<Out> out)
+    {
+        map_into(fn, out, in);
+    }
+
+    // same, with one argument to fn taken from each input column
+    template <typename Out, typename... Ins>
+    void map_into(Function fn, std::span<Out> out, std::span<const Ins>... ins)
+    {
+        constexpr auto NumArgs = sizeof...(Ins);
+#if S7_DEBUGGING
+        assert(((ins.size() >= out.size()) && ...) && "input column shorter than output");
+#endif
+        // c functions with an unboxed fast path don't need s7_call at all (an
+        // exception thrown by one then reaches the caller as is)
+        if constexpr(std::is_same_v<Out, double> && (std::is_same_v<Ins, double> && ...)) {
+            detail::DirectCall direct;
+            if constexpr(NumArgs == 1) {
+                if (auto f = s7_d_d_function(fn.ptr()); f) {
+                    for (std::size_t i = 0; i < out.size(); i++) {
+                        out[i] = f(ins[i]...);
+                    }
+                    return;
+                }
+            } else if constexpr(NumArgs == 2) {
+                if (auto f = s7_d_dd_function(fn.ptr()); f) {
+                    for (std::size_t i = 0; i < out.size(); i++) {
+                        out[i] = f(ins[i]...);
+                    }
+                    return;
+                }
+            }
+        }
+
+        detail::Entry entry(sc);
+        auto args = s7_make_list(sc, NumArgs, s7_nil(sc));
+        auto fn_loc = s7_gc_protect(sc, fn.ptr());
+        auto args_loc = s7_gc_protect(sc, args);
+        for (std::size_t i = 0; i < out.size(); i++) {
+            [[maybe_unused]] auto p = args;
+            ((s7_set_car(p, from(ins[i])), p = s7_cdr(p)), ...);
+            out[i] = to<Out>(s7_call(sc, fn.ptr(), args));
+        }
+        s7_gc_unprotect_at(sc, args_loc);
+        s7_gc_unprotect_at(sc, fn_loc);
+    }
+
+    s7_pointer apply(Function fn, List list)                             { detail::Entry entry(sc); return s7_apply_function(sc, fn.ptr(), list.ptr()); }
+    template <typename T> s7_pointer apply(Function fn, VarArgs<T> args) { detail::Entry entry(sc); return s7_apply_function(sc, fn.ptr(), args.ptr()); }
 
     /* function creation */
     template <typename F>
@@ -1318,20 +4322,48 @@ public:
                     :                                           s7_define_typed_function;
         auto sig = make_signature(func);
         if constexpr(function_has_varargs(func)) {
+            if (!f.fn) {
+                return s7_define_variable(sc, _name, detail::stored_value(sc, f, 0, -1, doc, sig));
+            }
             return define(sc, _name, f, 0, 0, true, doc.data(), sig);
         } else {
             constexpr auto NumArgs = FunctionTraits<F>::arity;
-            return define(sc, _name, f, NumArgs, 0, false, doc.data(), sig);
+            if (!f.fn) {
+                return s7_define_variable(sc, _name, detail::stored_value(sc, f, NumArgs, NumArgs, doc, sig));
+            }
+            auto sym = define(sc, _name, f, NumArgs, 0, false, doc.data(), sig);
+            detail::set_fast_paths<F>(sc, s7_symbol_value(sc, sym), opts, f);
+            return sym;
+        }
+    }
+
+    // for a function known at compile time, e.g. define_function<&add>("add", doc).
+    // nothing is stored for the binding and the call can be inlined
+    template <auto Fn>
+    s7_pointer define_function(std::string_view name, std::string_view doc, FunctionOpts opts = {})
+    {
+        return define_function(name, doc, detail::as_stateless<Fn>(Fn), opts);
+    }
+
+    // same, for a member function of a usertype: the object is the first argument
+    template <auto Fn>
+    s7_pointer bind_method(std::string_view name, std::string_view doc = {}, FunctionOpts opts = {})
+        requires std::is_member_function_pointer_v<decltype(Fn)>
+    {
+        if (doc.empty()) {
+            auto default_doc = std::format("({} obj ...) calls a method of obj", name);
+            return define_function(name, default_doc, detail::as_stateless<Fn>(Fn), opts);
         }
+        return define_function(name, doc, detail::as_stateless<Fn>(Fn), opts);
     }
 
     template <typename... Fns>
     s7_pointer define_function(std::string_view name, std::string_view doc, Overload<Fns...> &&overload, FunctionOpts opts = {})
     {
+        auto _name = s7_string(save_string(name));
         auto f = std::apply([&]<typename ...F>(F &&...fns) {
-            return detail::make_overload(sc, name, detail::as_lambda(fns)...);
+            return detail::make_overload(sc, _name, opts, detail::as_lambda(fns)...);
         }, overload.fns);
-        auto _name = s7_string(save_string(name));
         auto define = opts.unsafe_arglist || opts.unsafe_body
             ? s7_define_function
             : s7_define_safe_function;
@@ -1340,9 +4372,15 @@ public:
         }, overload.fns);
         constexpr auto MinArgs = detail::min_arity<Fns...>();
         if constexpr(has_varargs) {
+            if (!f.fn) {
+                return s7_define_variable(sc, _name, detail::stored_value(sc, f, MinArgs, -1, doc, nullptr));
+            }
             return define(sc, _name, f, MinArgs, 0, true, doc.data());
         } else {
             constexpr auto MaxArgs = detail::max_arity<Fns...>();
+            if (!f.fn) {
+                return s7_define_variable(sc, _name, detail::stored_value(sc, f, MinArgs, MaxArgs, doc, nullptr));
+            }
             return define(sc, _name, f, MinArgs, MaxArgs - MinArgs, false, doc.data());
         }
     }
@@ -1359,6 +4397,10 @@ public:
         auto _name = s7_string(save_string(name));
         auto f = detail::make_s7_function(sc, _name, func);
         auto sig = make_signature(func);
+        if (!f.fn) {
+            s7_define_variable(sc, _name, detail::stored_star_value(sc, f, arglist_desc, doc, sig));
+            return;
+        }
         s7_define_typed_function_star(sc, _name, f, arglist_desc.data(), doc.data(), sig);
     }
 
@@ -1373,6 +4415,10 @@ public:
         constexpr auto NumArgs = FunctionTraits<F>::arity;
         auto _name = s7_string(save_string(name));
         auto f = detail::make_s7_function(sc, _name, func);
+        if (!f.fn) {
+            s7_define_variable(sc, _name, detail::stored_value(sc, f, NumArgs, NumArgs, doc, nullptr, "macro"));
+            return;
+        }
         s7_define_macro(sc, _name, f, NumArgs, 0, false, doc.data());
     }
 
@@ -1389,22 +4435,34 @@ public:
     }
 
     /* usertypes */
-    template <typename T, typename... Fns>
+    template <typename T, typename Alloc = NewDelete, typename... Fns>
     s7_int make_usertype(std::string_view name, Constructors<Fns...> constructors, s7_pointer let)
     {
         auto tag = s7_make_c_type(sc, name.data());
-        detail::TypeTag<T>::tag.insert_or_assign(reinterpret_cast<uintptr_t>(sc), tag);
-        detail::TypeTag<T>::let.insert_or_assign(reinterpret_cast<uintptr_t>(sc), let);
+        auto info = detail::TypeInfo { .tag = tag, .let = let };
+        if constexpr(!std::is_same_v<Alloc, NewDelete>) {
+            info.allocate = &Alloc::template allocate<T>;
+            info.deallocate = &Alloc::template deallocate<T>;
+        }
+        detail::set_type_info<T>(sc, info);
+        // only objects reference the let, it must survive while there are none
+        s7_gc_protect(sc, let);
+        s7_openlet(sc, let);
 
         auto doc = std::format("(make-{} ...) creates a new {}", name, name);
-        auto ctor_name = !constructors.name.empty() ? constructors.name.data() : std::format("make-{}", name).c_str();
+        auto ctor_name = !constructors.name.empty() ? std::string(constructors.name) : std::format("make-{}", name);
              if constexpr(sizeof...(Fns) != 0)    { define_function(ctor_name, doc.c_str(), std::move(constructors.overload)); }
-        else if constexpr(requires { T(); })      { define_function(ctor_name, doc.c_str(), [this, tag]() -> s7_pointer { return make_c_object(tag, new T()); }); }
-        else if constexpr(requires { T(*this); }) { define_function(ctor_name, doc.c_str(), [this, tag]() -> s7_pointer { return make_c_object(tag, new T(*this)); }); }
+        else if constexpr(requires { T(); })      { define_function(ctor_name, doc.c_str(), [this]() -> s7_pointer { return detail::new_c_object<T>(sc); }); }
+        else if constexpr(requires { T(*this); }) { define_function(ctor_name, doc.c_str(), [this]() -> s7_pointer { return detail::new_c_object<T>(sc, *this); }); }
 
         s7_c_type_set_gc_free(sc, tag, [](s7_scheme *, s7_pointer obj) -> s7_pointer {
             T *o = reinterpret_cast<T *>(s7_c_object_value(obj));
-            delete o;
+            if constexpr(std::is_same_v<Alloc, NewDelete>) {
+                delete o;
+            } else {
+                o->~T();
+                Alloc::template deallocate<T>(o);
+            }
             return nullptr;
         });
 
@@ -1432,43 +4490,86 @@ public:
             });
         }
 
-        if constexpr(requires() { &T::operator[]; }) {
-            s7_c_type_set_ref(sc, tag, [](s7_scheme *sc, s7_pointer args) -> s7_pointer {
+        if constexpr(detail::has_index_operator<T>) {
+            using IndexOp = decltype(detail::index_operator<T>());
+            s7_function ref = [](s7_scheme *sc, s7_pointer args) -> s7_pointer {
                 auto &scheme = *reinterpret_cast<Scheme *>(&sc);
                 auto *obj = reinterpret_cast<T *>(s7_c_object_value(s7_car(args)));
-                using ArgType = typename FunctionTraits<decltype(&T::operator[])>::Argument<1>::Type;
+                using IndexType = typename FunctionTraits<IndexOp>::Argument<1>::Type;
+                using ArgType = detail::index_arg_t<IndexType>;
                 auto arg = s7_cadr(args);
-#ifdef S7_DEBUGGING
+#if S7_DEBUGGING
                 if (!scheme.is<ArgType>(arg)) {
                     auto s = std::format("a {}", scheme.type_to_string<ArgType>());
                     return s7_wrong_type_arg_error(sc, "T ref", 1, arg, s.c_str());
                 }
 #endif
-                return scheme.from((*obj)[scheme.to<ArgType>(arg)]);
-            });
+                return scheme.from((*obj)[static_cast<IndexType>(scheme.to<ArgType>(arg))]);
+            };
 
-            s7_c_type_set_set(sc, tag, [](s7_scheme *sc, s7_pointer args) -> s7_pointer {
+            s7_function set = [](s7_scheme *sc, s7_pointer args) -> s7_pointer {
                 auto &scheme = *reinterpret_cast<Scheme *>(&sc);
                 auto *obj = reinterpret_cast<T *>(s7_c_object_value(s7_car(args)));
-                using IndexType = typename FunctionTraits<decltype(&T::operator[])>::Argument<1>::Type;
-                using ValueType = std::remove_cvref_t<typename FunctionTraits<decltype(&T::operator[])>::ReturnType>;
+                using IndexType = typename FunctionTraits<IndexOp>::Argument<1>::Type;
+                using ArgType = detail::index_arg_t<IndexType>;
+                using ValueType = std::remove_cvref_t<typename FunctionTraits<IndexOp>::ReturnType>;
                 auto index = s7_cadr(args);
-#ifdef S7_DEBUGGING
-                if (!scheme.is<IndexType>(index)) {
-                    auto s = std::format("a {}", scheme.type_to_string<IndexType>());
+#if S7_DEBUGGING
+                if (!scheme.is<ArgType>(index)) {
+                    auto s = std::format("a {}", scheme.type_to_string<ArgType>());
                     return s7_wrong_type_arg_error(sc, "T ref", 1, index, s.c_str());
                 }
 #endif
                 auto value = s7_caddr(args);
-#ifdef S7_DEBUGGING
+#if S7_DEBUGGING
                 if (!scheme.is<ValueType>(value)) {
                     auto s = std::format("a {}", scheme.type_to_string<ValueType>());
                     return s7_wrong_type_arg_error(sc, "T ref", 2, value, s.c_str());
                 }
 #endif
-                (*obj)[scheme.to<IndexType>(index)] = scheme.to<ValueType>(value);
+                (*obj)[static_cast<IndexType>(scheme.to<ArgType>(index))] = scheme.to<ValueType>(value);
                 return s7_undefined(sc);
-            });
+            };
+
+            s7_c_type_set_ref(sc, tag, ref);
+            s7_c_type_set_set(sc, tag, set);
+
+            // when elements are reals, the optimizer can compile (v i) and
+            // (set! (v i) x) to direct calls on unboxed values, through the
+            // type's getter and setter
+            using RefType   = typename FunctionTraits<IndexOp>::ReturnType;
+            using IndexType = std::remove_cvref_t<typename FunctionTraits<IndexOp>::Argument<1>::Type>;
+            using ValueType = std::remove_cvref_t<RefType>;
+            if constexpr(std::is_floating_point_v<ValueType> && std::is_integral_v<IndexType>) {
+                auto getter_name = std::format("{}-ref", name);
+                auto getter = s7_make_safe_function(sc, s7_string(save_string(getter_name)), ref, 2, 0, false, "(getter obj i) returns element i");
+                s7_set_d_7pi_function(sc, getter, []([[maybe_unused]] s7_scheme *sc, s7_pointer obj, s7_int i) -> s7_double {
+#if S7_DEBUGGING
+                    if (!s7_is_c_object(obj) || s7_c_object_type(obj) != detail::get_type_tag<T>(sc)) {
+                        s7_wrong_type_arg_error(sc, "T ref", 1, obj, "a c-object of this type");
+                        return 0.0;
+                    }
+#endif
+                    return static_cast<s7_double>((*reinterpret_cast<T *>(s7_c_object_value(obj)))[static_cast<IndexType>(i)]);
+                });
+                s7_c_type_set_getter(sc, tag, getter);
+
+                if constexpr(std::is_lvalue_reference_v<RefType> && !std::is_const_v<std::remove_reference_t<RefType>>) {
+                    auto setter_name = std::format("{}-set!", name);
+                    auto setter = s7_make_safe_function(sc, s7_string(save_string(setter_name)), set, 3, 0, false, "(setter obj i x) sets element i to x");
+                    s7_set_d_7pid_function(sc, setter, []([[maybe_unused]] s7_scheme *sc, s7_pointer obj, s7_int i, s7_double x) -> s7_double {
+#if S7_DEBUGGING
+                        if (!s7_is_c_object(obj) || s7_c_object_type(obj) != detail::get_type_tag<T>(sc)) {
+                            s7_wrong_type_arg_error(sc, "T set", 1, obj, "a c-object of this type");
+                            return x;
+                        }
+#endif
+                        (*reinterpret_cast<T *>(s7_c_object_value(obj)))[static_cast<IndexType>(i)] = static_cast<ValueType>(x);
+                        return x;
+                    });
+                    s7_c_type_set_setter(sc, tag, setter);
+                }
+            }
         }
 
         s7_c_type_set_gc_mark(sc, tag, [](s7_scheme *, s7_pointer arg) -> s7_pointer {
@@ -1488,41 +4589,41 @@ public:
         return tag;
     }
 
-    template <typename T, typename... Fns>
+    template <typename T, typename Alloc = NewDelete, typename... Fns>
     s7_int make_usertype(std::string_view name, Constructors<Fns...> constructors = {})
     {
-        return make_usertype<T>(name, constructors, s7_inlet(sc, s7_nil(sc)));
+        return make_usertype<T, Alloc>(name, constructors, s7_inlet(sc, s7_nil(sc)));
     }
 
-    template <typename T, typename F, typename... Fns>
+    template <typename T, typename Alloc = NewDelete, typename F, typename... Fns>
     s7_int make_usertype(std::string_view name, Constructors<Fns...> constructors, s7_pointer let, Op op, F &&fn, auto&&... args)
     {
-        auto tag = make_usertype<T>(name, constructors, let, FWD(args)...);
+        auto tag = make_usertype<T, Alloc>(name, constructors, let, FWD(args)...);
         usertype_add_op<T>(name, tag, op, fn);
         return tag;
     }
 
-    template <typename T, typename F, typename... Fns>
+    template <typename T, typename Alloc = NewDelete, typename F, typename... Fns>
     s7_int make_usertype(std::string_view name, Constructors<Fns...> constructors, Op op, F &&fn, auto&&... args)
     {
-        auto tag = make_usertype<T>(name, constructors, FWD(args)...);
+        auto tag = make_usertype<T, Alloc>(name, constructors, FWD(args)...);
         usertype_add_op<T>(name, tag, op, fn);
         return tag;
     }
 
-    template <typename T, typename F, typename... Fns>
+    template <typename T, typename Alloc = NewDelete, typename F, typename... Fns>
     s7_int make_usertype(std::string_view name, Constructors<Fns...> constructors, MethodOp op, F &&fn, auto&&... args)
     {
         auto let = s7_inlet(sc, s7_nil(sc));
-        auto tag = make_usertype<T>(name, constructors, let, FWD(args)...);
+        auto tag = make_usertype<T, Alloc>(name, constructors, let, FWD(args)...);
         usertype_add_method_op<T>(name, let, op, fn);
         return tag;
     }
 
-    template <typename T, typename F, typename... Fns>
+    template <typename T, typename Alloc = NewDelete, typename F, typename... Fns>
     s7_int make_usertype(std::string_view name, Constructors<Fns...> constructors, s7_pointer let, MethodOp op, F &&fn, auto&&... args)
     {
-        auto tag = make_usertype<T>(name, constructors, let, FWD(args)...);
+        auto tag = make_usertype<T, Alloc>(name, constructors, let, FWD(args)...);
         usertype_add_method_op<T>(name, let, op, fn);
         return tag;
     }
@@ -1536,7 +4637,7 @@ public:
     template <typename T, typename F>
     void add_method_op(MethodOp op, F &&fn)
     {
-        usertype_add_method_op(detail::get_type_name<T>(sc), get_type_let<T>(), op, std::move(fn));
+        usertype_add_method_op<T>(detail::get_type_name<T>(sc), get_type_let<T>(), op, std::move(fn));
     }
 
     // also known as dilambda, but that is such a bad name (although technically right)
@@ -1549,9 +4650,26 @@ public:
         auto s = detail::make_s7_function(sc, name.data(), setter);
         auto gsig = make_signature(getter);
         auto ssig = make_signature(setter);
-        s7_define_variable(sc, name.data(),
-            s7_typed_dilambda(sc, name.data(), g, NumArgsF, 0,
-                                               s, NumArgsG, 0, doc.data(), gsig, ssig));
+        if (!g.fn || !s.fn) {
+            auto gv = detail::function_value(sc, g, NumArgsF, NumArgsF, doc, gsig, [&](s7_function f) {
+                return s7_make_typed_function(sc, name.data(), f, NumArgsF, 0, false, doc.data(), gsig);
+            });
+            auto loc = s7_gc_protect(sc, gv);
+            auto sv = detail::function_value(sc, s, NumArgsG, NumArgsG, doc, ssig, [&](s7_function f) {
+                return s7_make_typed_function(sc, name.data(), f, NumArgsG, 0, false, doc.data(), ssig);
+            });
+            s7_set_setter(sc, gv, sv);
+            s7_define_variable(sc, name.data(), gv);
+            s7_gc_unprotect_at(sc, loc);
+            return;
+        }
+        auto fn = s7_typed_dilambda(sc, name.data(), g, NumArgsF, 0,
+                                                     s, NumArgsG, 0, doc.data(), gsig, ssig);
+        // e.g. a double(const T &) getter gets d_v, so (v2-x v) in a loop
+        // reads the field without boxing it or building an arglist
+        detail::set_fast_paths<F>(sc, fn, {}, g);
+        detail::set_fast_paths<G>(sc, s7_setter(sc, fn), {}, s);
+        s7_define_variable(sc, name.data(), fn);
     }
 
     /* type related stuff */
@@ -1621,6 +4739,16 @@ public:
         return Function(m);
     }
 
+    template <fixed_string Name>
+    std::optional<Function> find_method(s7_pointer p, Symbol<Name> s)
+    {
+        auto m = s7_method(sc, p, sym(s));
+        if (!s7_is_procedure(m)) {
+            return std::nullopt;
+        }
+        return Function(m);
+    }
+
     std::string_view stacktrace() { return to_string(s7_stacktrace(sc)); }
 
     // probably worth noting: s7's history is reeeaaaally awkward. it's a circular list, yes, but it goes like this:
@@ -1670,6 +4798,384 @@ Variable Let::operator[](std::string_view name)
     return Variable(reinterpret_cast<Scheme *>(&sc), let, sym);
 }
 
+template <fixed_string Name>
+Variable Scheme::operator[](Symbol<Name> s)
+{
+    auto let = s7_rootlet(sc);
+    if (s7_let_ref(sc, let, sym(s)) == s7_undefined(sc)) {
+        s7_define(sc, let, sym(s), s7_nil(sc));
+    }
+    return Variable(this, let, sym(s));
+}
+
+template <fixed_string Name>
+Variable Let::operator[](Symbol<Name>)
+{
+    auto sym = detail::symbol<Name>(sc);
+    if (s7_let_ref(sc, let, sym) == s7_undefined(sc)) {
+        s7_define(sc, let, sym, s7_nil(sc));
+    }
+    return Variable(reinterpret_cast<Scheme *>(&sc), let, sym);
+}
+
+// eval_columns() with the rows split evenly among several instances, each
+// evaluating its share on its own thread. every instance must have whatever
+// definitions the expression uses.
+inline bool eval_columns(std::span<Scheme *const> schemes, std::string_view expr, std::span<const Column> columns,
+                         std::span<double> out, std::size_t chunk_size = 4096)
+{
+#if S7_DEBUGGING
+    assert(!schemes.empty() && "no instances to run on");
+    for (const auto &col : columns) {
+        assert(col.size() >= out.size() && "column shorter than output");
+    }
+#endif
+    auto per_thread = (out.size() + schemes.size() - 1) / schemes.size();
+    auto ok = std::vector<char>(schemes.size(), true);
+    auto run = [&](std::size_t i) {
+        auto begin = std::min(i * per_thread, out.size());
+        auto end = std::min(begin + per_thread, out.size());
+        ok[i] = detail::eval_column_rows(schemes[i]->ptr(), expr, columns, out, begin, end, chunk_size);
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < schemes.size(); i++) {
+        threads.emplace_back(run, i);
+    }
+    run(0);
+    for (auto &t : threads) {
+        t.join();
+    }
+    return std::all_of(ok.begin(), ok.end(), [](char b) { return b; });
+}
+
+/*
+ * a fixed number of interpreters, all set up by the same function, for hosts
+ * that run scheme on many threads. an instance is only used by one thread at
+ * a time, through a Lease:
+ *
+ *     s7::SchemePool pool([](s7::Scheme &scheme) { scheme.define_function(...); }, { .size = 32 });
+ *     // on any thread
+ *     auto scheme = pool.acquire();
+ *     scheme->call("handle", request);
+ *
+ * a thread gets back the instance it used last when that one is free, which
+ * keeps the per thread caches (symbols, usertype info) warm. instances are
+ * built in parallel by the constructor, and rebuilt when they are given back
+ * after max_uses leases or with a heap grown past max_heap_size cells, so
+ * state a request leaves behind doesn't build up.
+ */
+struct SchemePoolOptions {
+    std::size_t size = std::max(std::thread::hardware_concurrency(), 1u);
+    // 0 means no limit
+    std::size_t max_uses = 0;
+    s7_int max_heap_size = 0;
+};
+
+struct SchemeStats {
+    std::size_t leases;             // over the pool's lifetime
+    std::size_t uses;               // since the instance was last (re)built
+    std::size_t rebuilds;
+    std::size_t failed_rebuilds;    // setup threw; the old interpreter was kept
+    std::exception_ptr last_error;  // of the last failed rebuild, until one succeeds
+    s7_int heap_size;               // cells, as of the last time the instance was given back
+    double utilization;             // fraction of the pool's lifetime spent leased
+};
+
+class SchemePool {
+    using Clock = std::chrono::steady_clock;
+
+    struct Instance {
+        std::unique_ptr<Scheme> scheme;
+        std::thread::id last_thread;
+        bool leased = false;
+        std::size_t leases = 0;
+        std::size_t uses = 0;
+        std::size_t rebuilds = 0;
+        std::size_t failed_rebuilds = 0;
+        std::exception_ptr last_error;
+        s7_int heap_size = 0;
+        Clock::duration busy = {};
+        Clock::time_point leased_at;
+        // due for a rebuild that another thread will do, see give_back()
+        bool stale = false;
+    };
+
+    std::function<void(Scheme &)> setup;
+    SchemePoolOptions opts;
+    std::vector<Instance> instances;
+    std::vector<std::size_t> idle;
+    std::mutex mutex;
+    std::condition_variable available;
+    Clock::time_point created;
+    // no new leases while set, see give_back()
+    bool draining = false;
+
+    std::unique_ptr<Scheme> build()
+    {
+#if S7_DEBUGGING
+        // the checks of a debugging build of s7 go through a global pointer
+        // to the last interpreter made, so they can only be made one at a time
+        static std::mutex debug_mutex;
+        std::lock_guard<std::mutex> lock(debug_mutex);
+#endif
+        auto scheme = std::make_unique<Scheme>();
+        setup(*scheme);
+        return scheme;
+    }
+
+    static s7_int heap_size(Scheme &scheme)
+    {
+        return s7_integer(s7_starlet_ref(scheme.ptr(), detail::symbol<"heap-size">(scheme.ptr())));
+    }
+
+    // the instance this thread used last if it's idle, otherwise the one
+    // given back most recently. the lock must be held
+    std::size_t take()
+    {
+        auto self = std::this_thread::get_id();
+        auto it = std::find_if(idle.rbegin(), idle.rend(), [&](std::size_t i) { return instances[i].last_thread == self; });
+        auto pos = it != idle.rend() ? std::prev(it.base()) : std::prev(idle.end());
+        auto i = *pos;
+        idle.erase(pos);
+        auto &inst = instances[i];
+        inst.leased = true;
+        inst.last_thread = self;
+        inst.leases++;
+        inst.uses++;
+        inst.leased_at = Clock::now();
+        return i;
+    }
+
+    // replaces the interpreter of an instance nobody else is using, whose
+    // heap has heap cells. the old one is only destroyed once the new one is
+    // set up, so if setup throws the instance carries on as it was and the
+    // error shows up in stats()
+    void rebuild(Instance &inst, s7_int heap)
+    {
+        std::unique_ptr<Scheme> fresh;
+        std::exception_ptr error;
+        try {
+            fresh = build();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        if (fresh) {
+            heap = heap_size(*fresh);
+            std::swap(inst.scheme, fresh);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inst.stale = false;
+            inst.heap_size = heap;
+            if (error) {
+                inst.failed_rebuilds++;
+                inst.last_error = error;
+            } else {
+                inst.uses = 0;
+                inst.rebuilds++;
+                inst.last_error = nullptr;
+            }
+        }
+        // fresh holds the old interpreter now
+    }
+
+    void give_back(std::size_t i)
+    {
+        auto &inst = instances[i];
+        auto heap = heap_size(*inst.scheme);
+        bool due = (opts.max_uses != 0 && inst.uses >= opts.max_uses)
+                || (opts.max_heap_size != 0 && heap > opts.max_heap_size);
+#if S7_DEBUGGING
+        // the checks of a debugging build of s7 go through a global pointer to
+        // the last interpreter made, which mustn't change while other
+        // instances are running. so new leases wait, the rebuild waits for
+        // the other leases to come back, and instances due meanwhile are left
+        // to it. (a thread mustn't wait for a lease while holding another.)
+        if (due) {
+            std::unique_lock<std::mutex> lock(mutex);
+            inst.busy += Clock::now() - inst.leased_at;
+            inst.heap_size = heap;
+            if (draining) {
+                inst.stale = true;
+                inst.leased = false;
+                idle.push_back(i);
+                lock.unlock();
+                available.notify_all();
+                return;
+            }
+            draining = true;
+            available.wait(lock, [&] { return idle.size() + 1 == instances.size(); });
+            lock.unlock();
+            rebuild(inst, heap);
+            for (auto j : idle) {
+                if (instances[j].stale) {
+                    rebuild(instances[j], instances[j].heap_size);
+                }
+            }
+            lock.lock();
+            inst.leased = false;
+            idle.push_back(i);
+            draining = false;
+            lock.unlock();
+            available.notify_all();
+            return;
+        }
+#else
+        // still leased, so nothing else touches the instance while the thread
+        // giving it back rebuilds it
+        if (due) {
+            rebuild(inst, heap);
+        }
+#endif
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inst.busy += Clock::now() - inst.leased_at;
+            if (!due) {
+                inst.heap_size = heap;
+            }
+            inst.leased = false;
+            idle.push_back(i);
+        }
+        available.notify_all();
+    }
+
+public:
+    class Lease {
+        SchemePool *pool = nullptr;
+        std::size_t index = 0;
+        std::thread::id owner;
+
+        friend class SchemePool;
+        Lease(SchemePool *pool, std::size_t index) : pool(pool), index(index), owner(std::this_thread::get_id()) {}
+
+    public:
+        Lease(Lease &&other) { operator=(std::move(other)); }
+        Lease & operator=(Lease &&other)
+        {
+            if (this != &other) {
+                release();
+                pool = std::exchange(other.pool, nullptr);
+                index = other.index;
+                owner = other.owner;
+            }
+            return *this;
+        }
+        ~Lease() { release(); }
+
+        // gives the instance back early
+        void release()
+        {
+            if (pool) {
+                std::exchange(pool, nullptr)->give_back(index);
+            }
+        }
+
+        Scheme & operator*() const
+        {
+#if S7_DEBUGGING
+            assert(pool && "lease was released");
+            assert(owner == std::this_thread::get_id() && "lease used on a thread other than the one that acquired it");
+#endif
+            return *pool->instances[index].scheme;
+        }
+
+        Scheme * operator->() const { return &**this; }
+        std::size_t instance() const { return index; }
+    };
+
+    explicit SchemePool(std::function<void(Scheme &)> setup_fn, SchemePoolOptions options = {})
+        : setup(std::move(setup_fn)), opts(options), instances(std::max<std::size_t>(options.size, 1))
+    {
+        opts.size = instances.size();
+        std::vector<std::exception_ptr> errors(opts.size);
+        auto run = [&](std::size_t i) {
+            try {
+                instances[i].scheme = build();
+                instances[i].heap_size = heap_size(*instances[i].scheme);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+        run(0);
+#if S7_DEBUGGING
+        // builds are serialized anyway, and reading one interpreter while
+        // another is being made races on s7's debugging globals
+        for (std::size_t i = 1; i < opts.size; i++) {
+            run(i);
+        }
+#else
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < opts.size; i++) {
+            threads.emplace_back(run, i);
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+#endif
+        for (auto &e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+        for (std::size_t i = opts.size; i-- > 0; ) {
+            idle.push_back(i);
+        }
+        created = Clock::now();
+    }
+
+    // every lease must be given back before the pool goes away
+    ~SchemePool()
+    {
+#if S7_DEBUGGING
+        assert(idle.size() == instances.size() && "pool destroyed with instances still leased");
+#endif
+    }
+
+    SchemePool(const SchemePool &) = delete;
+    SchemePool & operator=(const SchemePool &) = delete;
+
+    // waits for an instance to be free
+    Lease acquire()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        available.wait(lock, [&] { return !idle.empty() && !draining; });
+        return Lease(this, take());
+    }
+
+    std::optional<Lease> try_acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (idle.empty() || draining) {
+            return std::nullopt;
+        }
+        return Lease(this, take());
+    }
+
+    std::size_t size() const { return instances.size(); }
+
+    std::vector<SchemeStats> stats()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto now = Clock::now();
+        auto lifetime = std::chrono::duration<double>(now - created).count();
+        std::vector<SchemeStats> res;
+        res.reserve(instances.size());
+        for (const auto &inst : instances) {
+            auto busy = inst.busy + (inst.leased ? now - inst.leased_at : Clock::duration{});
+            res.push_back({
+                .leases          = inst.leases,
+                .uses            = inst.uses,
+                .rebuilds        = inst.rebuilds,
+                .failed_rebuilds = inst.failed_rebuilds,
+                .last_error      = inst.last_error,
+                .heap_size       = inst.heap_size,
+                .utilization     = lifetime > 0.0 ? std::chrono::duration<double>(busy).count() / lifetime : 0.0,
+            });
+        }
+        return res;
+    }
+};
+
 struct Equal {
     Scheme *sc;
 
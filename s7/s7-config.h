@@ -6,4 +6,6 @@
 // #define DISABLE_FILE_OUTPUT 1
 
 #define WITH_WARNINGS 1
-#define S7_DEBUGGING 1
+#ifndef S7_DEBUGGING
+  #define S7_DEBUGGING 1
+#endif
@@ -1,6 +1,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <unordered_set>
+#include <map>
 #include "s7.hpp"
 #include "s7/s7.h"
 
@@ -283,6 +284,521 @@ void test_history()
     }
 }
 
+void test_fast_paths()
+{
+    s7::Scheme scheme;
+    scheme.make_usertype<v2>("v2", s7::Constructors("v2", [](double x, double y) { return v2 { .x = x, .y = y }; }));
+    scheme.define_function("add-double", "doc", add_double);
+    scheme.define_function("add-int", "doc", add_int);
+    scheme.define_function("v2-len", "doc", [](const v2 &v) { return v.x + v.y; });
+    scheme.define_function("v2-scale", "doc", [](const v2 &v, double k) { return v2 { .x = v.x * k, .y = v.y * k }; });
+    auto fn = [&](const char *name) { return s7_name_to_value(scheme.ptr(), name); };
+    printf("add-double: d_dd = %d\n", s7_d_dd_function(fn("add-double")) != nullptr);
+    printf("add-int: i_ii = %d\n", s7_i_ii_function(fn("add-int")) != nullptr);
+    printf("v2-len: d_v = %d\n", s7_d_v_function(fn("v2-len")) != nullptr);
+    printf("v2-scale: p_pp = %d\n", s7_p_pp_function(fn("v2-scale")) != nullptr);
+    scheme.load_string("(define (sum n) (let ((s 0.0) (v (v2 1.0 2.0))) (do ((i 0 (+ i 1))) ((= i n) s) (set! s (add-double s (v2-len v))))))");
+    printf("%s\n", scheme.to_string(scheme.eval("(sum 1000)")).data());
+}
+
+double sub_double(double a, double b) { return a - b; }
+
+void test_bindings()
+{
+    auto make_adder = [](s7_int n) { return [n](s7_int x) { return x + n; }; };
+    // a debug s7 wants functions defined on the newest interpreter
+    s7::Scheme a;
+    a.define_function("add-double", "doc", add_double);
+    a.define_function("sub-double", "doc", sub_double);
+    a.define_function("add1", "doc", make_adder(1));
+    s7::Scheme b;
+    b.define_function("add1", "doc", make_adder(100));
+    printf("%s\n", a.to_string(a.eval("(list (add-double 1.0 2.0) (sub-double 1.0 2.0) (add1 1))")).data());
+    printf("%s\n", b.to_string(b.eval("(add1 1)")).data());
+    // past S7_MAX_BINDINGS, functions keep their callable in an object of their own
+    s7::Scheme c;
+    for (int i = 0; i < 200; i++) {
+        c.define_function(std::format("add{}", i), "adds", make_adder(i));
+    }
+    c.define_star_function("scale", "x (k 2)", "doc", [n = 3](s7_int x, s7_int k) { return x * k + n; });
+    printf("%s\n", c.to_string(c.eval("(list (add5 1) (add199 1) (procedure? add199) (documentation add199))")).data());
+    printf("%s\n", c.to_string(c.eval("(list (scale 1) (scale 1 :k 3))")).data());
+}
+
+void test_overload()
+{
+    s7::Scheme scheme;
+    scheme.make_usertype<v2>("v2", s7::Constructors("v2", [](double x, double y) { return v2 { .x = x, .y = y }; }));
+    scheme.define_function("describe", "doc", s7::Overload(
+        [](s7_int) { return "integer"; },
+        [](double) { return "real"; },
+        [](const v2 &, double) { return "v2 and real"; },
+        [](s7_pointer, s7_pointer) { return "anything"; }
+    ), { .cache_overload = true });
+    printf("%s\n", scheme.to_string(scheme.eval("(list (describe 1) (describe 1.5) (describe (v2 1 2) 3) (describe 1 (v2 1 2)))")).data());
+    // #f converts to an empty optional, #t doesn't
+    scheme.define_function("describe-opt", "doc", s7::Overload(
+        [](std::optional<double> x) { return x ? "real" : "nothing"; },
+        [](bool) { return "boolean"; }
+    ));
+    printf("%s\n", scheme.to_string(scheme.eval("(list (describe-opt 1.5) (describe-opt #f) (describe-opt #t))")).data());
+    scheme.repl();
+}
+
+void test_prepare()
+{
+    s7::Scheme scheme;
+    scheme.load_string("(define total 0.0) (define (on-tick dt) (set! total (+ total dt)) total)");
+    auto tick = scheme.prepare<double(double)>("on-tick");
+    for (int i = 0; i < 10; i++) {
+        tick(0.1);
+    }
+    printf("total = %g\n", tick(0.0));
+}
+
+void test_callable()
+{
+    s7::Scheme scheme;
+    std::vector<s7::Callable<void(s7_int)>> handlers;
+    scheme.define_function("add-handler", "(add-handler fn) calls fn on every event", [&](s7::Callable<void(s7_int)> fn) {
+        handlers.push_back(std::move(fn));
+    });
+    scheme.load_string("(add-handler (lambda (x) (display x) (newline))) (add-handler (lambda (x) (display (* x 2)) (newline)))");
+    for (auto &handler : handlers) {
+        handler(21);
+    }
+    // an error caught by scheme leaves the call unfinished; later calls still work
+    scheme.load_string("(define (square-positive x) (if (< x 0) (error 'negative x) (* x x)))");
+    auto square = scheme.prepare<s7_int(s7_int)>("square-positive");
+    scheme.define_function("call-square", "(call-square x) squares a positive x from C++", [&](s7_int x) { return square(x); });
+    scheme.eval("(catch #t (lambda () (call-square -1)) (lambda args 'caught))");
+    printf("%ld %ld\n", square(3), scheme.to<s7_int>(scheme.eval("(call-square 4)")));
+}
+
+void test_map_into()
+{
+    s7::Scheme scheme;
+    scheme.load_string("(define (lerp a b) (+ a (* 0.5 (- b a))))");
+    std::vector<double> a = { 0, 1, 2 }, b = { 2, 3, 4 }, out(3);
+    auto lerp = s7::Function(s7_name_to_value(scheme.ptr(), "lerp"));
+    scheme.map_into(lerp, std::span<double>(out), std::span<const double>(a), std::span<const double>(b));
+    printf("%g %g %g\n", out[0], out[1], out[2]);
+}
+
+void test_compile_float()
+{
+    s7::Scheme scheme;
+    auto price = scheme.compile_float("(* k (+ x y))", {"x", "y", "k"});
+    printf("optimized: %d, (* 0.5 (+ 1 2)) = %g\n", price.optimized(), price(1.0, 2.0, 0.5));
+    scheme.load_string("(define (discount p) (* p 0.9))");
+    auto discounted = scheme.compile_float("(discount (+ x 1))", {"x"});
+    printf("optimized: %d, (discount (+ 9 1)) = %g\n", discounted.optimized(), discounted(9.0));
+    // compiled once, and again after anything else may have reused the optimizer's buffer
+    auto sum = scheme.compile_float("(+ x y)", {"x", "y"});
+    auto a = price(1.0, 2.0, 2.0);
+    auto b = sum(3.0, 4.0);
+    scheme.eval("(do ((i 0 (+ i 1)) (s 0.0 (+ s (* 2.0 i)))) ((= i 3) s))");
+    printf("%g %g %g %g\n", a, b, price(1.0, 1.0, 1.0), price(2.0, 2.0, 1.0));
+    // views into a longer string
+    std::string_view text = "(* x 2.0)(+ x 1.0)", names = "xy";
+    auto twice = scheme.compile_float(text.substr(0, 9), {names.substr(0, 1)});
+    printf("(* x 2.0) = %g\n", twice(4.0));
+}
+
+void test_eval_columns()
+{
+    s7::Scheme scheme;
+    std::vector<double> price = { 10.0, 20.0, 30.0 }, out(3);
+    std::vector<s7_int> qty = { 1, 2, 3 };
+    bool ok = scheme.eval_columns("(* price qty 0.9)", {
+        s7::Column("price", std::span<const double>(price)),
+        s7::Column("qty", std::span<const s7_int>(qty)),
+    }, out);
+    printf("ok = %d: %g %g %g\n", ok, out[0], out[1], out[2]);
+    // a binding of a column's name shadows the column
+    ok = scheme.eval_columns("(+ price (let ((qty 5.0)) qty) ((lambda (price) price) 1.0))", {
+        s7::Column("price", std::span<const double>(price)),
+        s7::Column("qty", std::span<const s7_int>(qty)),
+    }, out);
+    printf("ok = %d: %g %g %g\n", ok, out[0], out[1], out[2]);
+    scheme.load_string("(define-macro (with-qty v . body) `(let ((qty ,v)) ,@body))");
+    ok = scheme.eval_columns("(with-qty 2.0 (* price qty))", {
+        s7::Column("price", std::span<const double>(price)),
+        s7::Column("qty", std::span<const s7_int>(qty)),
+    }, out);
+    printf("ok = %d: %g %g %g\n", ok, out[0], out[1], out[2]);
+    // the expression is read as a datum, not pasted into other code
+    ok = scheme.eval_columns("(* price 2.0) ; doubled", {
+        s7::Column("price", std::span<const double>(price)),
+    }, out);
+    printf("ok = %d: %g %g %g\n", ok, out[0], out[1], out[2]);
+}
+
+void test_vector_interop()
+{
+    s7::Scheme scheme;
+    scheme.load_string("(define (total v) (let loop ((i 0) (sum 0.0)) (if (= i (length v)) sum (loop (+ i 1) (+ sum (v i))))))");
+
+    s7::FloatBuffer samples(4);
+    for (std::size_t i = 0; i < samples.size(); i++) {
+        samples[i] = double(i);
+    }
+    auto adopted = scheme.from(std::move(samples));
+    printf("adopted: %s, buffer now has %zu elements\n", scheme.to_string(adopted).data(), samples.size());
+
+    std::vector<double> data = { 1.0, 2.0, 3.0 };
+    scheme.load_string("(define kept #f)");
+    {
+        auto view = scheme.borrow(data);
+        printf("total = %g\n", scheme.to<double>(scheme.call("total", view)));
+        scheme.call("fill!", view, 10.0);
+        scheme.set("kept", view.ptr());
+    }
+    printf("data[0] = %g\n", data[0]);
+#if S7_DEBUGGING
+    // the wrapper outlived the borrow
+    printf("(length kept) = %s\n", scheme.to_string(scheme.eval("(length kept)")).data());
+#endif
+}
+
+void test_vector_conversion()
+{
+    s7::Scheme scheme;
+    std::vector<float> samples = { 0.5f, 1.5f, 2.5f };
+    scheme.define("samples", samples);
+    auto scaled = scheme.to<std::vector<float>>(scheme.eval("(apply float-vector (map (lambda (x) (* x 2)) samples))"));
+    printf("%g %g %g\n", scaled[0], scaled[1], scaled[2]);
+
+    scheme.define_function("sum-ids", "(sum-ids ids) sums an int-vector", [](std::vector<int> ids) {
+        s7_int sum = 0;
+        for (auto id : ids) {
+            sum += id;
+        }
+        return sum;
+    });
+    printf("sum-ids = %s\n", scheme.to_string(scheme.eval("(sum-ids #i(1 2 3))")).data());
+}
+
+void test_containers()
+{
+    s7::Scheme scheme;
+    std::map<std::string, double> config = { { "gain", 1.5 }, { "offset", -0.25 } };
+    scheme.define("config", config);
+    scheme.define("layout", std::vector<std::vector<s7_int>> { { 1, 2 }, { 3 } });
+    scheme.define("origin", std::tuple<double, double, std::string>(0.0, 1.0, "top-left"));
+    printf("gain = %s, layout = %s, origin = %s\n",
+        scheme.to_string(scheme.eval("(config \"gain\")")).data(),
+        scheme.to_string(scheme.eval("layout")).data(),
+        scheme.to_string(scheme.eval("origin")).data());
+
+    scheme.define_function("describe", "(describe result) summarizes a result table",
+        [](const std::map<std::string, std::vector<double>> &results, std::optional<std::string> label) {
+            return std::format("{}: {} series", label.value_or("results"), results.size());
+        });
+    printf("%s\n", scheme.to_string(scheme.eval("(describe (hash-table \"a\" #r(1 2) \"b\" #r()) #f)")).data());
+
+    auto evens = std::views::iota(0, 10) | std::views::filter([](int i) { return i % 2 == 0; });
+    auto back = scheme.to<std::vector<s7_int>>(scheme.from(evens));
+    printf("%zu evens, last = %ld\n", back.size(), back.back());
+}
+
+void test_mdspan()
+{
+    s7::Scheme scheme;
+    scheme.define_function("blur-rows!", "(blur-rows! image) averages each pixel with its right neighbour",
+        [](s7::MdSpan<double, 2> image) {
+            for (std::size_t i = 0; i < image.extent(0); i++) {
+                for (std::size_t j = 0; j + 1 < image.extent(1); j++) {
+                    image(i, j) = (image(i, j) + image(i, j + 1)) / 2.0;
+                }
+            }
+        });
+    scheme.load_string("(define image (make-float-vector '(2 3) 0.0)) (set! (image 0 2) 4.0) (blur-rows! image)");
+    printf("image = %s\n", scheme.to_string(scheme.eval("image")).data());
+
+    std::vector<double> pixels = { 1, 2, 3, 4, 5, 6 };
+    auto view = s7::MdSpan<double, 2>(pixels.data(), { 3, 2 });
+    auto borrowed = scheme.borrow(view);
+    printf("borrowed = %s, (v 2 1) = %s\n", scheme.to_string(borrowed.ptr()).data(),
+        scheme.to_string(s7_vector_ref_n(scheme.ptr(), borrowed.ptr(), 2, 2, 1)).data());
+}
+
+void test_call_borrowed()
+{
+    s7::Scheme scheme;
+    scheme.load_string("(define (route msg) (if (char=? (msg 0) #\\G) 'reader 'writer))");
+    std::string payload = "GET /status HTTP/1.1";
+    printf("%s\n", scheme.to_string(scheme.call_borrowed("route", payload)).data());
+    std::string_view rest = std::string_view(payload).substr(4, 7);
+    printf("%s\n", scheme.to_string(scheme.call_borrowed("string-length", rest)).data());
+}
+
+void test_symbols()
+{
+    s7::Scheme scheme;
+    scheme.define("dt", 0.016, "frame time");
+    scheme.set(s7::sym<"dt">, scheme.get<double>(s7::sym<"dt">) * 2);
+    printf("dt = %g\n", scheme.get<double>("dt"));
+    scheme[s7::sym<"frame">] = 10;
+    printf("frame = %d\n", int(scheme[s7::sym<"frame">].to<s7_int>()));
+    auto let = scheme.new_empty_let();
+    let.define(s7::sym<"speed">, 3.5, "player speed");
+    let.set(s7::sym<"speed">, 4.0);
+    printf("speed = %g\n", let.get<double>(s7::sym<"speed">));
+    printf("%d\n", scheme.sym(s7::sym<"dt">) == scheme.sym("dt"));
+}
+
+void test_bound_variable()
+{
+    s7::Scheme scheme;
+    auto timer = scheme.variable<double>("timer");
+    auto frame = scheme.variable<s7_int>(s7::sym<"frame">);
+    timer = 0.5;
+    frame = 1;
+    scheme.eval("(define start timer)");
+    timer.set_in_place(0.75);
+    printf("%s %s %s\n", scheme.to_string(scheme.eval("start")).data(),
+                          scheme.to_string(scheme.eval("timer")).data(),
+                          scheme.to_string(scheme.eval("frame")).data());
+    scheme.eval("(set! frame (+ frame 1))");
+    printf("%d\n", int(frame.get()));
+    // a name that's part of a longer string
+    std::string_view names = "speed,accel";
+    auto let = scheme.new_empty_let();
+    let.define("speed", 2.0);
+    auto speed = let.variable<double>(names.substr(0, 5));
+    speed = 3.0;
+    printf("%g\n", let.get<double>("speed"));
+}
+
+void test_bind_variable()
+{
+    struct Engine {
+        double dt = 0.016;
+        s7_int frame = 0;
+    } engine;
+    s7::Scheme scheme;
+    scheme.bind_variable("dt", &engine.dt, "frame time");
+    scheme.bind_variable(s7::sym<"frame">, &engine.frame, "frame number");
+    engine.dt = 0.025;
+    printf("%s\n", scheme.to_string(scheme.eval("(* dt 2)")).data());
+    scheme.eval("(begin (set! dt 0.5) (set! frame (+ frame 1)))");
+    printf("%g %d\n", engine.dt, int(engine.frame));
+    scheme.eval("(define (frame-time) (* dt frame))");
+    auto frame_time = scheme.prepare<double()>("frame-time");
+    engine.frame = 4;
+    printf("%g\n", frame_time());
+    // a change made by a bound function is seen as soon as it returns
+    scheme.define_function("bump!", "doc", [&] { engine.dt = 2.0; });
+    scheme.define_function("double-dt", "doc", [&](double x) { engine.dt *= 2; return x; });
+    printf("%s\n", scheme.to_string(scheme.eval("(let ((before dt)) (bump!) (list before dt))")).data());
+    scheme.eval("(define (twice-dt) (let ((s 0.0)) (do ((i 0 (+ i 1))) ((= i 2) dt) (set! s (double-dt s)))))");
+    printf("%s\n", scheme.to_string(scheme.call("twice-dt")).data());
+}
+
+void test_pool_allocator()
+{
+    s7::Scheme scheme;
+    scheme.make_usertype<v2, s7::PoolAllocator<>>("v2", s7::Constructors("v2", [](double x, double y) { return v2 { .x = x, .y = y }; }));
+    scheme.eval("(define (churn n) (do ((i 0 (+ i 1)) (v #f (v2 i i))) ((= i n) v)))");
+    scheme.call("churn", 100000);
+    scheme.eval("(gc)");
+    auto stats = s7::PoolAllocator<>::stats<v2>();
+    printf("live: %zu, peak: %zu\n", stats.live, stats.peak);
+    // an object made with new is moved into the pool
+    scheme.define("made", scheme.make_c_object(new v2 { .x = 1, .y = 2 }));
+    scheme.eval("(set! made #f)");
+    scheme.eval("(gc)");
+    stats = s7::PoolAllocator<>::stats<v2>();
+    printf("live: %zu\n", stats.live);
+}
+
+void test_method_ops()
+{
+    s7::Scheme scheme;
+    scheme.make_usertype<v2>("v2",
+        s7::Constructors("v2", [](double x, double y) { return v2 { .x = x, .y = y }; }),
+        s7::Op::ToString, [](const v2 &v) -> std::string { return std::format("v2({}, {})", v.x, v.y); },
+        s7::MethodOp::Add, &v2::operator+=,
+        s7::MethodOp::Sub, [](const v2 &a, const v2 &b) { return v2 { .x = a.x - b.x, .y = a.y - b.y }; },
+        s7::MethodOp::Neg, [](const v2 &v) { return v2 { .x = -v.x, .y = -v.y }; },
+        s7::MethodOp::Mul, s7::Overload(
+            s7::resolve<v2(double, v2)>(&operator*),
+            s7::resolve<v2(v2, double)>(&operator*)
+        ),
+        s7::MethodOp::Lt, [](const v2 &a, const v2 &b) { return a.x*a.x + a.y*a.y < b.x*b.x + b.y*b.y; },
+        s7::MethodOp::Eq, [](const v2 &a, const v2 &b) { return a.x == b.x && a.y == b.y; },
+        s7::MethodOp::Abs, [](const v2 &v) { return std::sqrt(v.x*v.x + v.y*v.y); }
+    );
+    for (auto expr : {
+        "(+ (v2 1 2) (v2 3 4))",
+        "(+ (v2 1 2) (v2 3 4) (v2 5 6))",
+        "(- (v2 1 2) (v2 3 4))",
+        "(- (v2 1 2))",
+        "(* 2.0 (v2 1 2))",
+        "(* (v2 1 2) 3.0)",
+        "(< (v2 1 2) (v2 3 4))",
+        "(< (v2 3 4) (v2 1 2))",
+        "(< (v2 1 0) (v2 2 0) (v2 3 0))",
+        "(= (v2 1 2) (v2 1 2))",
+        "(abs (v2 3 4))",
+        "(+ 1 2 3)",
+        "(< 1 2.5)",
+        "(abs -3)",
+        "(- 5)",
+    }) {
+        printf("%s = %s\n", expr, scheme.to_string(scheme.eval(expr)).data());
+    }
+}
+
+void test_static_bindings()
+{
+    s7::Scheme scheme;
+    scheme.make_usertype<Set>("set",
+        s7::Constructors([&]() { return Set(scheme); }),
+        s7::Op::GcMark, [&](const Set &s) { return s.gc_mark(scheme); });
+    scheme.define_function<&add_double>("add-double", "(add-double a b) adds a and b");
+    scheme.bind_method<&Set::add>("set-add!");
+    printf("add-double: d_dd = %d\n", s7_d_dd_function(s7_name_to_value(scheme.ptr(), "add-double")) != nullptr);
+    printf("%s\n", scheme.to_string(scheme.eval("(add-double 1.0 2.5)")).data());
+    printf("%s\n", scheme.to_string(scheme.eval("(let ((s (make-set))) (set-add! s 1) (set-add! s 'a))")).data());
+    printf("%s\n", scheme.to_string(scheme.eval("(documentation set-add!)")).data());
+}
+
+void test_unboxed_ref()
+{
+    s7::Scheme scheme;
+    scheme.make_usertype<v2>("v2", s7::Constructors("v2", [](double x, double y) { return v2 { .x = x, .y = y }; }));
+    auto v = scheme.eval("(v2 1.0 2.0)");
+    scheme.define("v", v, "a v2");
+    scheme.eval("(define (sum n) (let ((s 0.0)) (do ((i 0 (+ i 1))) ((= i n) s) (set! s (+ s (v 0) (v 1))))))");
+    scheme.eval("(define (bump! n) (do ((i 0 (+ i 1))) ((= i n) v) (set! (v 0) (+ (v 0) 1.0)) (set! (v 1) (* (v 1) 2.0))))");
+    printf("%s\n", scheme.to_string(scheme.call("sum", 10)).data());
+    scheme.call("bump!", 3);
+    printf("%g %g\n", scheme.to<v2 &>(v).x, scheme.to<v2 &>(v).y);
+    printf("%s\n", scheme.to_string(scheme.eval("(begin (set! (v 1) 0.5) (list (v 0) (v 1)))")).data());
+}
+
+void test_property_fast_paths()
+{
+    s7::Scheme scheme;
+    scheme.make_usertype<v2>("v2", s7::Constructors("v2", [](double x, double y) { return v2 { .x = x, .y = y }; }));
+    scheme.define_property("v2-x", "(v2-x v2) accesses x", [](const v2 &v) { return v.x; }, [](v2 &v, double x) { v.x = x; });
+    auto getter = s7_name_to_value(scheme.ptr(), "v2-x");
+    printf("v2-x: d_v = %d\n", s7_d_v_function(getter) != nullptr);
+    printf("(setter v2-x): p_pp = %d\n", s7_p_pp_function(s7_setter(scheme.ptr(), getter)) != nullptr);
+    scheme.eval("(define (sum v n) (let ((s 0.0)) (do ((i 0 (+ i 1))) ((= i n) s) (set! s (+ s (v2-x v))))))");
+    printf("%s\n", scheme.to_string(scheme.eval("(let ((v (v2 1.5 0.0))) (set! (v2-x v) 2.5) (sum v 4))")).data());
+}
+
+void test_exceptions()
+{
+    s7::Scheme scheme;
+    scheme.define_function("at", "(at i) returns element i of a 3-element array", [](s7_int i) {
+        return std::array<double, 3>{1.0, 2.0, 3.0}.at(std::size_t(i));
+    });
+    scheme.define_function("checked-sqrt", "(checked-sqrt x) throws on negative x", [](double x) {
+        if (x < 0.0) {
+            throw std::invalid_argument("negative argument");
+        }
+        return std::sqrt(x);
+    });
+    printf("%s\n", scheme.to_string(scheme.eval("(catch 'out-of-range (lambda () (at 5)) (lambda (type info) (list type (apply format #f info))))")).data());
+    scheme.eval("(define (sum-roots n) (do ((i 0 (+ i 1)) (s 0.0 (+ s (checked-sqrt (- 3.0 i))))) ((= i n) s)))");
+    printf("%s\n", scheme.to_string(scheme.eval("(catch #t (lambda () (sum-roots 10)) (lambda (type info) type))")).data());
+    printf("sum-roots 4 = %g\n", scheme.to<double>(scheme.eval("(sum-roots 4)")));
+    auto ok = scheme.call_checked("at", 1);
+    printf("ok: %d, %g\n", ok.has_value(), ok ? scheme.to<double>(*ok) : 0.0);
+    for (int i = 0; i < 3; i++) {
+        auto err = scheme.call_checked("car", 1);
+        printf("err: %d, %s\n", err.has_value(), err ? "" : std::string(err.error().type).c_str());
+    }
+    auto thrown = scheme.call_checked("at", 7);
+    printf("thrown: %s: %s\n", std::string(thrown.error().type).c_str(),
+           scheme.to_string(thrown.error().info.ptr()).data());
+    auto fast = scheme.call_checked("sum-roots", 10);
+    printf("fast path: %s\n", std::string(fast.error().type).c_str());
+    scheme.define_function("nested-car", "(nested-car x) is (car x), or #f on error", [&](s7_pointer x) {
+        auto r = scheme.call_checked("car", x);
+        return r ? *r : s7_f(scheme.ptr());
+    });
+    printf("%s\n", scheme.to_string(scheme.eval("(list (nested-car 1) (nested-car '(2 3)) (+ 1 (car (list (nested-car '(4))))))")).data());
+    auto nested = scheme.call_checked("nested-car", s7_int(1));
+    printf("nested: %s\n", scheme.to_string(*nested).data());
+    printf("still usable: %s\n", scheme.to_string(scheme.eval("(+ 1 2)")).data());
+    // through a Callable it's a scheme error, called directly it's the exception
+    scheme.eval("(define (safe-root x) (catch #t (lambda () (checked-sqrt x)) (lambda (type info) -1.0)))");
+    printf("safe-root: %g\n", scheme.prepare<double(double)>("safe-root")(-4.0));
+    auto root = scheme.compile_float("(checked-sqrt x)", {"x"});
+    try {
+        root(-4.0);
+    } catch (const std::invalid_argument &e) {
+        printf("compiled: %s\n", e.what());
+    }
+    std::vector<double> in = { 4.0, -4.0 }, out(2);
+    try {
+        scheme.map_into(s7::Function(s7_name_to_value(scheme.ptr(), "checked-sqrt")), std::span<const double>(in), std::span<double>(out));
+    } catch (const std::invalid_argument &e) {
+        printf("map_into: %s\n", e.what());
+    }
+}
+
+void test_scheme_pool()
+{
+    s7::SchemePool pool([](s7::Scheme &scheme) {
+        scheme.make_usertype<v2>("v2", s7::Constructors("v2", [](double x, double y) { return v2 { .x = x, .y = y }; }));
+        scheme.define_function("twice", "(twice x) returns 2x", [](s7_int x) { return 2 * x; });
+        scheme.eval("(define uses 0)");
+    }, { .size = 4, .max_uses = 50 });
+    std::atomic<int> wrong = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 500; i++) {
+                auto scheme = pool.acquire();
+                scheme->eval("(set! uses (+ uses 1))");
+                if (scheme->to<s7_int>(scheme->call("twice", s7_int(t * i))) != 2 * t * i || scheme->to<s7_int>(scheme->eval("uses")) > 50) {
+                    wrong++;
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    std::size_t leases = 0, rebuilds = 0;
+    for (auto s : pool.stats()) {
+        leases += s.leases;
+        rebuilds += s.rebuilds;
+    }
+    printf("wrong results: %d, leases: %zu, rebuilt: %d\n", wrong.load(), leases, rebuilds > 0);
+    std::size_t first;
+    {
+        auto scheme = pool.acquire();
+        first = scheme.instance();
+    }
+    auto scheme = pool.acquire();
+    printf("same thread, same instance: %d\n", scheme.instance() == first);
+    std::vector<s7::SchemePool::Lease> rest;
+    for (int i = 0; i < 3; i++) {
+        rest.push_back(pool.acquire());
+    }
+    printf("try_acquire with all leased: %d\n", pool.try_acquire().has_value());
+
+    int builds = 0;
+    s7::SchemePool flaky([&](s7::Scheme &scheme) {
+        if (++builds == 2) {
+            throw std::runtime_error("setup failed");
+        }
+        scheme.eval("(define answer 42)");
+    }, { .size = 1, .max_uses = 1 });
+    flaky.acquire();
+    auto stats = flaky.stats()[0];
+    printf("failed rebuilds: %zu, error kept: %d\n", stats.failed_rebuilds, bool(stats.last_error));
+    auto kept = flaky.acquire();
+    printf("old interpreter still works: %ld\n", kept->to<s7_int>(kept->eval("answer")));
+}
+
 int main(int argc, char *argv[])
 {
     // test_scheme_defined_function();
@@ -296,6 +812,29 @@ int main(int argc, char *argv[])
     // test_sig();
     // test_type_of();
     // test_complex();
+    // test_fast_paths();
+    // test_bindings();
+    // test_overload();
+    // test_prepare();
+    // test_callable();
+    // test_map_into();
+    // test_compile_float();
+    // test_eval_columns();
+    // test_vector_interop();
+    // test_vector_conversion();
+    // test_containers();
+    // test_mdspan();
+    // test_call_borrowed();
+    // test_symbols();
+    // test_bound_variable();
+    // test_bind_variable();
+    // test_pool_allocator();
+    // test_method_ops();
+    // test_static_bindings();
+    // test_unboxed_ref();
+    // test_property_fast_paths();
+    // test_exceptions();
+    // test_scheme_pool();
     test_history();
 }
 